@@ -0,0 +1,60 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseInterchangePipeline.h"
+
+#include "JamLicenseSourceURLs.h"
+
+#include "InterchangeSourceData.h"
+
+bool UJamLicenseSourceURLPipeline::ExecutePreImportPipeline(UInterchangeBaseNodeContainer* BaseNodeContainer, const TArray<UInterchangeSourceData*>& SourceDatas)
+{
+	// Runs on a worker thread, only reads the settings and the source file path
+	ResolvedURL = AssetSourceURL;
+
+	if (bUseSourcePathRules && (SourceDatas.Num() > 0) && (SourceDatas[0] != nullptr))
+	{
+		const FString RuleURL = FJamLicenseSourceURLs::FindURLForSourceFile(SourceDatas[0]->GetFilename());
+		if (!RuleURL.IsEmpty())
+		{
+			ResolvedURL = RuleURL;
+		}
+	}
+
+	return true;
+}
+
+bool UJamLicenseSourceURLPipeline::ExecutePostImportPipeline(const UInterchangeBaseNodeContainer* BaseNodeContainer, const FString& NodeKey, UObject* CreatedAsset, bool bIsAReimport)
+{
+	if ((CreatedAsset != nullptr) && !ResolvedURL.IsEmpty())
+	{
+		// Keep whatever was there before for reimports, the URL may have been set by hand
+		FJamLicenseSourceURLs::SetAssetSourceURL(CreatedAsset, ResolvedURL, /*bKeepExistingURL=*/ bIsAReimport);
+	}
+
+	return true;
+}
+
+bool UJamLicenseSourceURLPipeline::CanExecuteOnAnyThread(EInterchangePipelineTask PipelineTask)
+{
+	// The pre-import step doesn't touch any UObjects, so it shouldn't hold up the parallel translate/factory work,
+	// but writing package metadata in the post-import step has to happen on the game thread (it's only a map insert)
+	return (PipelineTask != EInterchangePipelineTask::PostFactoryImport);
+}
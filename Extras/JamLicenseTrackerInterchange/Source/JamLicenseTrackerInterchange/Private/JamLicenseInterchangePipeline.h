@@ -0,0 +1,60 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "InterchangePipelineBase.h"
+
+#include "JamLicenseInterchangePipeline.generated.h"
+
+class UInterchangeBaseNodeContainer;
+class UInterchangeSourceData;
+
+// Interchange pipeline that stamps the asset source URL onto every asset as it is created, so bulk imports
+// don't need a second load/modify/save pass afterwards
+//
+// Add an asset of this class to the pipeline stacks in the Interchange project settings. It lives in its own plugin
+// (JamLicenseTrackerInterchange) so JamLicenseTracker itself doesn't require Interchange
+UCLASS(BlueprintType, Blueprintable, EditInlineNew, meta=(DisplayName="Asset Source URL"))
+class UJamLicenseSourceURLPipeline : public UInterchangePipelineBase
+{
+	GENERATED_BODY()
+
+public:
+	// The asset source URL to assign to every imported asset
+	UPROPERTY(EditAnywhere, Category="Asset Source")
+	FString AssetSourceURL;
+
+	// Should the source path rules from the plugin settings be used to pick the URL from the imported file path?
+	// When a rule matches it takes priority over AssetSourceURL
+	UPROPERTY(EditAnywhere, Category="Asset Source")
+	bool bUseSourcePathRules = true;
+
+protected:
+	//~UInterchangePipelineBase interface
+	virtual bool ExecutePreImportPipeline(UInterchangeBaseNodeContainer* BaseNodeContainer, const TArray<UInterchangeSourceData*>& SourceDatas) override;
+	virtual bool ExecutePostImportPipeline(const UInterchangeBaseNodeContainer* BaseNodeContainer, const FString& NodeKey, UObject* CreatedAsset, bool bIsAReimport) override;
+	virtual bool CanExecuteOnAnyThread(EInterchangePipelineTask PipelineTask) override;
+	//~End of UInterchangePipelineBase interface
+
+private:
+	// The URL resolved for the file being imported by this pipeline instance
+	FString ResolvedURL;
+};
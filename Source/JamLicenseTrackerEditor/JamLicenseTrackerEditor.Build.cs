@@ -33,13 +33,25 @@ public class JamLicenseTrackerEditor : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			"CoreUObject",
 			"Engine",
+			"AssetRegistry",
+			"DeveloperSettings",
 			"Slate",
 			"SlateCore",
 			"JamLicenseTrackerRuntime",
 			"ToolMenus",
 			"ContentBrowser",
+			"CollectionManager",
 			"SharedSettingsWidgets",
+			"SourceControl",
+			"MessageLog",
 			"UnrealEd",
+			"WorkspaceMenuStructure",
+			"Json",
+			"Sockets",
+			"Networking",
+			"DirectoryWatcher",
+			"PropertyEditor",
+			"Projects",
 		});
 	}
 }
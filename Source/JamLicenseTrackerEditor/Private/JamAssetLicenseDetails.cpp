@@ -0,0 +1,149 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamAssetLicenseDetails.h"
+
+#include "JamAssetLicense.h"
+#include "SJamLicenseTextPreview.h"
+
+#include "DetailCategoryBuilder.h"
+#include "DetailLayoutBuilder.h"
+#include "DetailWidgetRow.h"
+#include "IDetailPropertyRow.h"
+#include "Modules/ModuleManager.h"
+#include "PropertyEditorModule.h"
+#include "PropertyHandle.h"
+#include "Widgets/SBoxPanel.h"
+
+TSharedRef<IDetailCustomization> FJamAssetLicenseDetails::MakeInstance()
+{
+	return MakeShared<FJamAssetLicenseDetails>();
+}
+
+void FJamAssetLicenseDetails::Register()
+{
+	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	PropertyModule.RegisterCustomClassLayout(UJamAssetLicense::StaticClass()->GetFName(), FOnGetDetailCustomizationInstance::CreateStatic(&FJamAssetLicenseDetails::MakeInstance));
+	PropertyModule.NotifyCustomizationModuleChanged();
+}
+
+void FJamAssetLicenseDetails::Unregister()
+{
+	if (FPropertyEditorModule* PropertyModule = FModuleManager::GetModulePtr<FPropertyEditorModule>("PropertyEditor"))
+	{
+		PropertyModule->UnregisterCustomClassLayout(UJamAssetLicense::StaticClass()->GetFName());
+		PropertyModule->NotifyCustomizationModuleChanged();
+	}
+}
+
+void FJamAssetLicenseDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
+{
+	TSharedRef<IPropertyHandle> LicenseTextHandle = DetailBuilder.GetProperty(GET_MEMBER_NAME_CHECKED(UJamAssetLicense, LicenseText));
+	if (!LicenseTextHandle->IsValidHandle())
+	{
+		return;
+	}
+
+	if (IDetailPropertyRow* LicenseTextRow = DetailBuilder.EditDefaultProperty(LicenseTextHandle))
+	{
+		LicenseTextRow->CustomWidget()
+		.NameContent()
+		[
+			LicenseTextHandle->CreatePropertyNameWidget()
+		]
+		.ValueContent()
+		.MinDesiredWidth(400.0f)
+		.MaxDesiredWidth(1200.0f)
+		[
+			SNew(SJamLicenseTextPreview, LicenseTextHandle)
+		];
+	}
+
+	CustomizeLocalizedLicenseText(DetailBuilder);
+}
+
+void FJamAssetLicenseDetails::CustomizeLocalizedLicenseText(IDetailLayoutBuilder& DetailBuilder)
+{
+	TSharedRef<IPropertyHandle> MapHandle = DetailBuilder.GetProperty(GET_MEMBER_NAME_CHECKED(UJamAssetLicense, LocalizedLicenseText));
+	TSharedPtr<IPropertyHandleMap> MapInterface = MapHandle->AsMap();
+	if (!MapHandle->IsValidHandle() || !MapInterface.IsValid())
+	{
+		return;
+	}
+
+	// With several licenses selected the entries don't line up, so that case keeps the default rows
+	uint32 NumEntries = 0;
+	if (MapInterface->GetNumElements(/*out*/ NumEntries) != FPropertyAccess::Success)
+	{
+		return;
+	}
+
+	// The rows below are built per entry, so adding or removing one has to rebuild them
+	MapInterface->SetOnNumElementsChanged(FSimpleDelegate::CreateLambda([&DetailBuilder]()
+	{
+		DetailBuilder.ForceRefreshDetails();
+	}));
+
+	IDetailCategoryBuilder& Category = DetailBuilder.EditCategory(MapHandle->GetDefaultCategoryName());
+	DetailBuilder.HideProperty(MapHandle);
+
+	Category.AddCustomRow(MapHandle->GetPropertyDisplayName())
+	.NameContent()
+	[
+		MapHandle->CreatePropertyNameWidget()
+	]
+	.ValueContent()
+	[
+		MapHandle->CreateDefaultPropertyButtonWidgets()
+	];
+
+	for (uint32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+	{
+		TSharedPtr<IPropertyHandle> ValueHandle = MapHandle->GetChildHandle(EntryIndex);
+		TSharedPtr<IPropertyHandle> KeyHandle = ValueHandle.IsValid() ? ValueHandle->GetKeyHandle() : nullptr;
+		if (!KeyHandle.IsValid())
+		{
+			continue;
+		}
+
+		Category.AddCustomRow(MapHandle->GetPropertyDisplayName())
+		.NameContent()
+		[
+			KeyHandle->CreatePropertyValueWidget()
+		]
+		.ValueContent()
+		.MinDesiredWidth(400.0f)
+		.MaxDesiredWidth(1200.0f)
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			[
+				SNew(SJamLicenseTextPreview, ValueHandle.ToSharedRef())
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Top)
+			[
+				ValueHandle->CreateDefaultPropertyButtonWidgets()
+			]
+		];
+	}
+}
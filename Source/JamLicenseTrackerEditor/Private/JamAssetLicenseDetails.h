@@ -0,0 +1,42 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IDetailCustomization.h"
+
+// Replaces the multi-line text boxes for UJamAssetLicense::LicenseText and the LocalizedLicenseText values with
+// SJamLicenseTextPreview, so selecting a license with a very large text doesn't lay the whole thing out in the details panel
+class FJamAssetLicenseDetails : public IDetailCustomization
+{
+public:
+	static TSharedRef<IDetailCustomization> MakeInstance();
+
+	static void Register();
+	static void Unregister();
+
+	//~IDetailCustomization interface
+	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
+	//~End of IDetailCustomization interface
+
+private:
+	void CustomizeLocalizedLicenseText(IDetailLayoutBuilder& DetailBuilder);
+};
@@ -0,0 +1,158 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseArchiveCommandlet.h"
+
+#include "JamLicenseManifest.h"
+#include "JamLicenseManifestArchive.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "Misc/Parse.h"
+
+UJamLicenseArchiveCommandlet::UJamLicenseArchiveCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UJamLicenseArchiveCommandlet::Main(const FString& Params)
+{
+	FString ArchiveDir = FJamLicenseManifestArchive::GetDefaultDirectory();
+	FParse::Value(*Params, TEXT("Archive="), /*out*/ ArchiveDir);
+	FJamLicenseManifestArchive Archive(ArchiveDir);
+
+	FString BuildId;
+	FParse::Value(*Params, TEXT("BuildId="), /*out*/ BuildId);
+
+	if (FParse::Param(*Params, TEXT("Store")))
+	{
+		FString ManifestFilename = FJamLicenseManifest::GetDefaultFilename();
+		FParse::Value(*Params, TEXT("Manifest="), /*out*/ ManifestFilename);
+
+		FJamLicenseManifest Manifest;
+		FString Error;
+		if (BuildId.IsEmpty() || !Manifest.LoadFromFile(ManifestFilename, /*out*/ Error))
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s"), BuildId.IsEmpty() ? TEXT("-Store needs a -BuildId") : *Error);
+			return 1;
+		}
+
+		TArray<FJamLicenseManifestCultureSection> CultureSections;
+		for (const FString& Culture : Manifest.Cultures)
+		{
+			FJamLicenseManifestCultureSection& Section = CultureSections.AddDefaulted_GetRef();
+			if (!Section.LoadFromFile(FJamLicenseManifestCultureSection::GetFilename(ManifestFilename, Culture), /*out*/ Error))
+			{
+				UE_LOG(LogJamLicenseTracker, Error, TEXT("%s"), *Error);
+				return 1;
+			}
+		}
+
+		const FString RootHash = Archive.StoreBuild(BuildId, Manifest, CultureSections);
+		if (RootHash.IsEmpty())
+		{
+			return 1;
+		}
+
+		UE_LOG(LogJamLicenseTracker, Display, TEXT("Archived build %s as %s"), *BuildId, *RootHash);
+		return 0;
+	}
+	else if (FParse::Param(*Params, TEXT("Diff")))
+	{
+		FString FromBuildId;
+		FString ToBuildId;
+		FParse::Value(*Params, TEXT("From="), /*out*/ FromBuildId);
+		FParse::Value(*Params, TEXT("To="), /*out*/ ToBuildId);
+
+		FJamLicenseManifestDiff Diff;
+		FString Error;
+		if (!Archive.Diff(FromBuildId, ToBuildId, /*out*/ Diff, /*out*/ Error))
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s"), *Error);
+			return 1;
+		}
+
+		for (const FString& URL : Diff.AddedURLs)
+		{
+			UE_LOG(LogJamLicenseTracker, Display, TEXT("+ %s"), *URL);
+		}
+		for (const FString& URL : Diff.RemovedURLs)
+		{
+			UE_LOG(LogJamLicenseTracker, Display, TEXT("- %s"), *URL);
+		}
+		for (const FJamLicenseManifestDiff::FChangedLicense& Changed : Diff.ChangedLicenses)
+		{
+			TArray<FString> Parts;
+			if (Changed.bLicenseAssetChanged) { Parts.Add(TEXT("license asset")); }
+			if (Changed.bSPDXChanged) { Parts.Add(TEXT("SPDX identifier")); }
+			if (Changed.bPlatformsChanged) { Parts.Add(TEXT("allowed platforms")); }
+			if (Changed.bTextChanged) { Parts.Add(TEXT("license text")); }
+			if ((Changed.AddedPackages.Num() > 0) || (Changed.RemovedPackages.Num() > 0))
+			{
+				Parts.Add(FString::Printf(TEXT("%d packages added, %d removed"), Changed.AddedPackages.Num(), Changed.RemovedPackages.Num()));
+			}
+			UE_LOG(LogJamLicenseTracker, Display, TEXT("~ %s (%s)"), *Changed.AssetSourceURL, *FString::Join(Parts, TEXT(", ")));
+
+			for (FName Package : Changed.AddedPackages)
+			{
+				UE_LOG(LogJamLicenseTracker, Verbose, TEXT("    + %s"), *Package.ToString());
+			}
+			for (FName Package : Changed.RemovedPackages)
+			{
+				UE_LOG(LogJamLicenseTracker, Verbose, TEXT("    - %s"), *Package.ToString());
+			}
+		}
+		for (const FString& Culture : Diff.ChangedCultures)
+		{
+			UE_LOG(LogJamLicenseTracker, Display, TEXT("~ localized texts for %s"), *Culture);
+		}
+
+		UE_LOG(LogJamLicenseTracker, Display, TEXT("%s -> %s: %d licenses added, %d removed, %d changed"), *FromBuildId, *ToBuildId, Diff.AddedURLs.Num(), Diff.RemovedURLs.Num(), Diff.ChangedLicenses.Num());
+		return 0;
+	}
+	else if (FParse::Param(*Params, TEXT("Extract")))
+	{
+		FString OutputFilename;
+		FParse::Value(*Params, TEXT("Output="), /*out*/ OutputFilename);
+
+		FJamLicenseManifest Manifest;
+		FString Error;
+		if (OutputFilename.IsEmpty() || !Archive.LoadBuild(BuildId, /*out*/ Manifest, /*out*/ Error))
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s"), OutputFilename.IsEmpty() ? TEXT("-Extract needs an -Output") : *Error);
+			return 1;
+		}
+
+		return Manifest.SaveToFile(OutputFilename) ? 0 : 1;
+	}
+	else if (FParse::Param(*Params, TEXT("List")))
+	{
+		for (const TPair<FString, FString>& Build : Archive.GetBuilds())
+		{
+			UE_LOG(LogJamLicenseTracker, Display, TEXT("%s %s"), *Build.Value, *Build.Key);
+		}
+		return 0;
+	}
+
+	UE_LOG(LogJamLicenseTracker, Error, TEXT("Expected one of -Store, -Diff, -Extract or -List"));
+	return 1;
+}
@@ -0,0 +1,45 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "JamLicenseArchiveCommandlet.generated.h"
+
+// Maintains the content-addressed archive of shipped license manifests (see FJamLicenseManifestArchive)
+//
+// Usage: UnrealEditor-Cmd.exe MyProject.uproject -run=JamLicenseArchive [-Archive=Path/To/Archive] <mode>
+//   -Store -BuildId=<id> [-Manifest=Path/To/LicenseManifest.json]    Archives a harvested manifest under a build id
+//   -Diff -From=<id> -To=<id>                                        Lists the license changes between two builds
+//   -Extract -BuildId=<id> -Output=Path/To/LicenseManifest.json      Writes out the manifest of an archived build
+//   -List                                                            Lists the archived builds
+UCLASS()
+class UJamLicenseArchiveCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJamLicenseArchiveCommandlet();
+
+	//~UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~End of UCommandlet interface
+};
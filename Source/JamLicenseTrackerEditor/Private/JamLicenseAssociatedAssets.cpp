@@ -0,0 +1,92 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseAssociatedAssets.h"
+
+#include "JamLicenseIndex.h"
+
+#include "AssetData.h"
+#include "IAssetRegistry.h"
+
+void FJamLicenseAssociatedAssets::FindMatching(const TSet<FString>& AssetSourceURLs, TArray<FAssetData>& OutMatches)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const FName NAME_AssetSourceURL(MD_AssetSourceURL);
+
+	// Neither path below copies the tag value out of the registry, so the scan itself doesn't allocate per asset
+	if (FJamLicenseIndex::IsAvailable() && IsInGameThread())
+	{
+		// The index has already interned every URL (including unsaved edits), so the candidates come from it rather than
+		// from the registry tags, which would miss assets whose URL was only just added and include ones whose URL was just changed
+		const FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+
+		TBitArray<> WantedURLIds(false, Index.GetNumURLIds());
+		bool bAnyKnownURL = false;
+		for (const FString& URL : AssetSourceURLs)
+		{
+			const int32 URLId = Index.FindURLId(URL);
+			if (URLId != INDEX_NONE)
+			{
+				WantedURLIds[URLId] = true;
+				bAnyKnownURL = true;
+			}
+		}
+
+		if (bAnyKnownURL)
+		{
+			FARFilter Filter;
+			for (const TPair<FName, int32>& Pair : Index.GetAssetURLIds())
+			{
+				if (WantedURLIds[Pair.Value])
+				{
+					Filter.ObjectPaths.Add(Pair.Key);
+				}
+			}
+
+			if (Filter.ObjectPaths.Num() > 0)
+			{
+				AssetRegistry.GetAssets(Filter, /*out*/ OutMatches);
+			}
+		}
+	}
+	else
+	{
+		TArray<FAssetData> PotentialAssetList;
+		AssetRegistry.GetAssetsByTags({ NAME_AssetSourceURL }, /*out*/  PotentialAssetList);
+		OutMatches.Reserve(OutMatches.Num() + PotentialAssetList.Num());
+
+		// Compare against the registry's stored representation of the tag (there are usually only a handful of URLs)
+		for (const FAssetData& AssetData : PotentialAssetList)
+		{
+			const FAssetTagValueRef TestURL = AssetData.TagsAndValues.FindTag(NAME_AssetSourceURL);
+			if (TestURL.IsSet())
+			{
+				for (const FString& URL : AssetSourceURLs)
+				{
+					if (TestURL.Equals(URL))
+					{
+						OutMatches.Add(AssetData);
+						break;
+					}
+				}
+			}
+		}
+	}
+}
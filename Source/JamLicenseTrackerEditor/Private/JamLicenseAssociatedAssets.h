@@ -0,0 +1,34 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+
+// Finds the assets associated with licenses (i.e., sharing their asset source URL)
+class FJamLicenseAssociatedAssets
+{
+public:
+	// Appends every asset whose source URL tag is one of the URLs, straight from the asset registry (unloaded assets included)
+	// When the license index is available (game thread), matching goes through its URL ids, so unsaved source URL edits are respected
+	static void FindMatching(const TSet<FString>& AssetSourceURLs, TArray<FAssetData>& OutMatches);
+};
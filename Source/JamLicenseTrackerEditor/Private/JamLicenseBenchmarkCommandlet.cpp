@@ -0,0 +1,137 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseBenchmarkCommandlet.h"
+
+#include "JamLicenseBenchmark.h"
+#include "JamLicenseEditorBenchmark.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "HAL/FileManager.h"
+#include "IAssetRegistry.h"
+#include "Misc/App.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+UJamLicenseBenchmarkCommandlet::UJamLicenseBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UJamLicenseBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumIterations = 20;
+	int32 SelectionSize = 1000;
+	double Threshold = 0.2;
+	FString OutputFilename = FPaths::ProjectSavedDir() / TEXT("JamLicenseTracker") / TEXT("Benchmarks") / FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString());
+	FString BaselineFilename = FPaths::ProjectDir() / TEXT("Build") / TEXT("JamLicenseTracker") / TEXT("BenchmarkBaseline.json");
+
+	FParse::Value(*Params, TEXT("Iterations="), /*out*/ NumIterations);
+	FParse::Value(*Params, TEXT("SelectionSize="), /*out*/ SelectionSize);
+	FParse::Value(*Params, TEXT("Threshold="), /*out*/ Threshold);
+	FParse::Value(*Params, TEXT("Output="), /*out*/ OutputFilename);
+	const bool bExplicitBaseline = FParse::Value(*Params, TEXT("Baseline="), /*out*/ BaselineFilename);
+	const bool bWriteBaseline = FParse::Param(*Params, TEXT("WriteBaseline"));
+
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(/*bSynchronousSearch=*/ true);
+
+	const bool bCreatedIndex = !FJamLicenseIndex::IsAvailable();
+	if (bCreatedIndex)
+	{
+		FJamLicenseIndex::Initialize();
+	}
+
+	FJamLicenseEditorBenchmark Benchmark;
+	Benchmark.NumIterations = NumIterations;
+	Benchmark.SelectionSize = SelectionSize;
+
+	FJamLicenseBenchmarkReport Report;
+	FString BenchmarkError;
+	const bool bBenchmarked = Benchmark.Run(/*out*/ Report, /*out*/ BenchmarkError);
+
+	if (bCreatedIndex)
+	{
+		FJamLicenseIndex::Shutdown();
+	}
+
+	if (!bBenchmarked)
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("%s"), *BenchmarkError);
+		return 1;
+	}
+
+	Report.LogSummary();
+
+	// Budgets are absolute, so they are checked even when there is no baseline (or one is being written)
+	const TArray<FString> BudgetOverruns = FJamLicenseEditorBenchmark::FindBudgetOverruns(Report);
+	for (const FString& Overrun : BudgetOverruns)
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Over budget: %s"), *Overrun);
+	}
+	const int32 BudgetResult = (BudgetOverruns.Num() == 0) ? 0 : 1;
+
+	if (!Report.SaveToFile(OutputFilename))
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to write benchmark report to %s"), *OutputFilename);
+		return 1;
+	}
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("Wrote benchmark report to %s"), *OutputFilename);
+
+	if (bWriteBaseline)
+	{
+		if (!Report.SaveToFile(BaselineFilename))
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to write baseline to %s"), *BaselineFilename);
+			return 1;
+		}
+		UE_LOG(LogJamLicenseTracker, Display, TEXT("Wrote baseline to %s"), *BaselineFilename);
+		return BudgetResult;
+	}
+
+	if (!IFileManager::Get().FileExists(*BaselineFilename))
+	{
+		UE_LOG(LogJamLicenseTracker, Display, TEXT("No baseline at %s, run with -WriteBaseline to record one"), *BaselineFilename);
+		return bExplicitBaseline ? 1 : BudgetResult;
+	}
+
+	FJamLicenseBenchmarkReport Baseline;
+	FString Error;
+	if (!Baseline.LoadFromFile(BaselineFilename, /*out*/ Error))
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+
+	const TArray<FString> Regressions = Report.FindRegressions(Baseline, Threshold);
+	for (const FString& Regression : Regressions)
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Regression: %s"), *Regression);
+	}
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("%d regressions over %.0f%% against %s"), Regressions.Num(), Threshold * 100.0, *BaselineFilename);
+
+	return (Regressions.Num() == 0) ? BudgetResult : 1;
+}
@@ -0,0 +1,53 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "JamLicenseBenchmarkCommandlet.generated.h"
+
+// Benchmarks the plugin's license operations against the project's content and compares them to a baseline
+//
+// Usage: UnrealEditor-Cmd.exe MyProject.uproject -run=JamLicenseBenchmark [options]
+//   -Iterations=20           Timed samples per benchmark (index build and audit use fewer, they are much slower)
+//   -SelectionSize=1000      Number of assets in each simulated Content Browser selection
+//   -Output=<file>           Where to write the JSON report (defaults to Saved/JamLicenseTracker/Benchmarks)
+//   -Baseline=<file>         Baseline to compare against (defaults to Build/JamLicenseTracker/BenchmarkBaseline.json)
+//   -Threshold=0.2           Fail if any median time or memory growth rose by more than this fraction over the baseline
+//   -WriteBaseline           Write this run's report over the baseline instead of comparing against it
+//
+// Benchmarks: IndexBuild, MenuState (selection summary from tags), AssociatedAssets (Select Associated Assets
+// matching), Audit (manifest harvest), ManifestLoad, RuntimeQuery (batches of manifest lookups by URL), and
+// BadgePaint / BadgeRefresh (license state badges in one Content Browser repaint). The badge benchmarks also fail
+// the run if they go over the 0.1 ms repaint budget, with or without a baseline.
+// Use JamLicenseGenerateTestContent to get a content set big enough to be interesting
+UCLASS()
+class UJamLicenseBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJamLicenseBenchmarkCommandlet();
+
+	//~UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~End of UCommandlet interface
+};
@@ -0,0 +1,139 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseBudget.h"
+
+#include "JamLicenseMemory.h"
+#include "JamLicenseTrackerLog.h"
+#include "JamLicenseTrackerSettings.h"
+
+#include "HAL/IConsoleManager.h"
+
+namespace JamLicenseBudget
+{
+	// Upper bounds of the histogram buckets in milliseconds (roughly doubling, with the frame times of 60/30/15 Hz in the middle)
+	static const double BucketLimitsMs[] = { 0.5, 1.0, 2.0, 4.0, 8.0, 16.7, 33.3, 66.7, 133.0, 266.0, 533.0 };
+	static constexpr int32 NumBuckets = UE_ARRAY_COUNT(BucketLimitsMs) + 1;
+
+	struct FHistogram
+	{
+		int64 NumCalls = 0;
+		int64 NumOverBudget = 0;
+		double TotalMs = 0.0;
+		double MaxMs = 0.0;
+		int64 Buckets[NumBuckets] = {};
+	};
+
+	// Game thread only
+	static TMap<FString, FHistogram> Histograms;
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice BudgetCommand(
+		TEXT("JamLicense.Budget"),
+		TEXT("Prints a histogram of the game thread time taken by each license tracker menu and callback (pass 'reset' to clear it)"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if ((Args.Num() > 0) && (Args[0] == TEXT("reset")))
+			{
+				FJamLicenseBudgetScope::ResetHistograms();
+				Ar.Logf(TEXT("Cleared the license tracker budget histograms"));
+			}
+			else
+			{
+				FJamLicenseBudgetScope::PrintHistograms(Ar);
+			}
+		}));
+}
+
+FJamLicenseBudgetScope::FJamLicenseBudgetScope(const TCHAR* InName)
+	: Name(InName)
+	, StartCycles(FPlatformTime::Cycles64())
+{
+	check(IsInGameThread());
+}
+
+FJamLicenseBudgetScope::~FJamLicenseBudgetScope()
+{
+	using namespace JamLicenseBudget;
+
+	const double ElapsedMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	const float BudgetMs = GetDefault<UJamLicenseTrackerSettings>()->GameThreadBudgetMs;
+	const bool bOverBudget = (BudgetMs > 0.0f) && (ElapsedMs > BudgetMs);
+
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+	FHistogram& Histogram = Histograms.FindOrAdd(Name);
+	Histogram.NumCalls++;
+	Histogram.TotalMs += ElapsedMs;
+	Histogram.MaxMs = FMath::Max(Histogram.MaxMs, ElapsedMs);
+
+	int32 Bucket = 0;
+	while ((Bucket < NumBuckets - 1) && (ElapsedMs > BucketLimitsMs[Bucket]))
+	{
+		++Bucket;
+	}
+	Histogram.Buckets[Bucket]++;
+
+	if (bOverBudget)
+	{
+		Histogram.NumOverBudget++;
+
+		FString ContextText;
+		for (const TPair<const TCHAR*, int64>& Pair : Context)
+		{
+			ContextText += FString::Printf(TEXT(" %s=%lld"), Pair.Key, Pair.Value);
+		}
+
+		UE_LOG(LogJamLicenseTracker, Warning, TEXT("%s took %.2f ms on the game thread (budget %.2f ms)%s"), Name, ElapsedMs, BudgetMs, *ContextText);
+	}
+}
+
+void FJamLicenseBudgetScope::PrintHistograms(FOutputDevice& Ar)
+{
+	using namespace JamLicenseBudget;
+
+	FString Header = FString::Printf(TEXT("%-28s %8s %8s %9s %9s "), TEXT("Callback"), TEXT("Calls"), TEXT("Over"), TEXT("MeanMs"), TEXT("MaxMs"));
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Header += (Bucket < NumBuckets - 1) ? FString::Printf(TEXT(" <=%-6g"), BucketLimitsMs[Bucket]) : FString::Printf(TEXT("  >%-6g"), BucketLimitsMs[Bucket - 1]);
+	}
+
+	Ar.Logf(TEXT("License tracker game thread time (budget %.2f ms):"), GetDefault<UJamLicenseTrackerSettings>()->GameThreadBudgetMs);
+	Ar.Logf(TEXT("%s"), *Header);
+
+	TArray<FString> Names;
+	Histograms.GenerateKeyArray(/*out*/ Names);
+	Names.Sort();
+
+	for (const FString& CallbackName : Names)
+	{
+		const FHistogram& Histogram = Histograms[CallbackName];
+
+		FString Line = FString::Printf(TEXT("%-28s %8lld %8lld %9.2f %9.2f "), *CallbackName, Histogram.NumCalls, Histogram.NumOverBudget, Histogram.TotalMs / FMath::Max<int64>(Histogram.NumCalls, 1), Histogram.MaxMs);
+		for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+		{
+			Line += FString::Printf(TEXT(" %8lld"), Histogram.Buckets[Bucket]);
+		}
+		Ar.Logf(TEXT("%s"), *Line);
+	}
+}
+
+void FJamLicenseBudgetScope::ResetHistograms()
+{
+	JamLicenseBudget::Histograms.Reset();
+}
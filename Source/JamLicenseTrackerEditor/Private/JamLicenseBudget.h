@@ -0,0 +1,49 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Times a plugin callback that runs on the game thread (menu builders, menu actions, startup checks)
+//
+// Every call is recorded in a per-callback histogram that the JamLicense.Budget console command prints, and calls
+// that take longer than UJamLicenseTrackerSettings::GameThreadBudgetMs are logged as warnings along with any
+// context attached via AddContext (e.g., how many assets were selected)
+class FJamLicenseBudgetScope
+{
+public:
+	explicit FJamLicenseBudgetScope(const TCHAR* InName);
+	~FJamLicenseBudgetScope();
+
+	// Attaches a value to the over-budget warning (cheap, it's only formatted if the call goes over)
+	void AddContext(const TCHAR* Key, int64 Value)
+	{
+		Context.Emplace(Key, Value);
+	}
+
+	static void PrintHistograms(FOutputDevice& Ar);
+	static void ResetHistograms();
+
+private:
+	const TCHAR* Name;
+	uint64 StartCycles;
+	TArray<TPair<const TCHAR*, int64>, TInlineAllocator<4>> Context;
+};
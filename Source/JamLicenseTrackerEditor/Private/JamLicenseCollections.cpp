@@ -0,0 +1,327 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseCollections.h"
+
+#include "JamLicenseIndex.h"
+#include "JamLicenseTrackerSettings.h"
+
+#include "CollectionManagerModule.h"
+#include "ContentBrowserModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "ICollectionManager.h"
+#include "IContentBrowserSingleton.h"
+#include "JamLicenseTrackerLog.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Modules/ModuleManager.h"
+#include "SourceControlOperations.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Widgets/SWindow.h"
+
+#define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
+
+const FName FJamLicenseCollections::AssociatedAssetsCollectionName(TEXT("LicenseAssociatedAssets"));
+
+void FJamLicenseCollections::ShowInAssociatedAssetsCollection(const TArray<FName>& ObjectPaths)
+{
+	ICollectionManager& CollectionManager = FCollectionManagerModule::GetModule().Get();
+	const ECollectionShareType::Type ShareType = ECollectionShareType::CST_Local;
+
+	if (CollectionManager.CollectionExists(AssociatedAssetsCollectionName, ShareType))
+	{
+		CollectionManager.EmptyCollection(AssociatedAssetsCollectionName, ShareType);
+	}
+	else if (!CollectionManager.CreateCollection(AssociatedAssetsCollectionName, ShareType, ECollectionStorageMode::Static))
+	{
+		UE_LOG(LogJamLicenseTracker, Warning, TEXT("Failed to create collection %s: %s"), *AssociatedAssetsCollectionName.ToString(), *CollectionManager.GetLastError().ToString());
+		return;
+	}
+
+	// Emptying already saved the collection once, adding everything in one call keeps it to a single further save
+	CollectionManager.AddToCollection(AssociatedAssetsCollectionName, ShareType, ObjectPaths);
+
+	FAssetPickerConfig PickerConfig;
+	PickerConfig.Collections.Add(FCollectionNameType(AssociatedAssetsCollectionName, ShareType));
+	PickerConfig.InitialAssetViewType = EAssetViewType::List;
+	PickerConfig.SelectionMode = ESelectionMode::Multi;
+	PickerConfig.bAllowDragging = true;
+	PickerConfig.bCanShowClasses = false;
+	PickerConfig.OnAssetDoubleClicked = FOnAssetDoubleClicked::CreateLambda([](const FAssetData& AssetData)
+	{
+		FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+		ContentBrowserModule.Get().SyncBrowserToAssets({ AssetData }, /*bAllowLockedBrowsers=*/ false, /*bFocusContentBrowser=*/ true);
+	});
+
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(FText::Format(LOCTEXT("AssociatedAssetsWindowTitle", "Associated Assets ({0})"), FText::AsNumber(ObjectPaths.Num())))
+		.ClientSize(FVector2D(800.0f, 600.0f))
+		[
+			ContentBrowserModule.Get().CreateAssetPicker(PickerConfig)
+		];
+
+	FSlateApplication::Get().AddWindow(Window);
+}
+
+FName FJamLicenseCollections::MakeCollectionName(const FString& URL, FName LicenseAsset)
+{
+	FString BaseName;
+	if (!LicenseAsset.IsNone())
+	{
+		BaseName = FPackageName::ObjectPathToObjectName(LicenseAsset.ToString());
+	}
+	else
+	{
+		// Drop the scheme and keep the most identifying part of the URL
+		BaseName = URL;
+		int32 SchemeEnd = BaseName.Find(TEXT("://"));
+		if (SchemeEnd != INDEX_NONE)
+		{
+			BaseName.RightChopInline(SchemeEnd + 3, /*bAllowShrinking=*/ false);
+		}
+	}
+
+	for (TCHAR& Char : BaseName)
+	{
+		if (!FChar::IsAlnum(Char) && (Char != TEXT('-')) && (Char != TEXT('.')))
+		{
+			Char = TEXT('_');
+		}
+	}
+
+	// Collection names share a namespace, so keep them short and make them unique per URL. FJamLicenseIndex merges URLs
+	// that only differ in case into one entry (FString map keys compare case-insensitively), and the spelling it keeps
+	// depends on which asset it saw first, so the hash deliberately ignores case too to keep the name stable
+	BaseName.LeftInline(64, /*bAllowShrinking=*/ false);
+	return FName(*FString::Printf(TEXT("%s_%08X"), *BaseName, FCrc::StrCrc32(*URL.ToLower())));
+}
+
+bool FJamLicenseCollections::IsGeneratedCollectionName(FName Name)
+{
+	const FString NameString = Name.ToString();
+	const int32 SuffixStart = NameString.Len() - 9;
+	if ((SuffixStart < 0) || (NameString[SuffixStart] != TEXT('_')))
+	{
+		return false;
+	}
+
+	for (int32 Index = SuffixStart + 1; Index < NameString.Len(); ++Index)
+	{
+		const TCHAR Char = NameString[Index];
+		if (!FChar::IsDigit(Char) && !((Char >= TEXT('A')) && (Char <= TEXT('F'))))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FJamLicenseCollections::RefreshLicenseCollections()
+{
+	const UJamLicenseTrackerSettings* Settings = GetDefault<UJamLicenseTrackerSettings>();
+	ECollectionShareType::Type ShareType = ECollectionShareType::CST_Local;
+	FString CollectionDir = FPaths::ProjectSavedDir() / TEXT("Collections");
+	switch (Settings->LicenseCollectionShareType)
+	{
+	case EJamLicenseCollectionShareType::Private:
+		ShareType = ECollectionShareType::CST_Private;
+		CollectionDir = FPaths::GameUserDeveloperDir() / TEXT("Collections");
+		break;
+	case EJamLicenseCollectionShareType::Shared:
+		ShareType = ECollectionShareType::CST_Shared;
+		CollectionDir = FPaths::ProjectContentDir() / TEXT("Collections");
+		break;
+	default:
+		break;
+	}
+
+	const FName ParentName = Settings->LicenseCollectionsParentName;
+	if (ParentName.IsNone())
+	{
+		return;
+	}
+
+	ICollectionManager& CollectionManager = FCollectionManagerModule::GetModule().Get();
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	const FJamLicenseURLSortData& URLData = Index.GetURLSortData();
+
+	// Group every asset by URL in one pass over the index
+	TArray<TArray<FName>> AssetsByURLId;
+	AssetsByURLId.SetNum(Index.GetNumURLIds());
+	for (const TPair<FName, int32>& Pair : Index.GetAssetURLIds())
+	{
+		AssetsByURLId[Pair.Value].Add(Pair.Key);
+	}
+
+	// Work out what needs to change
+	struct FPendingCollection
+	{
+		FName Name;
+		TArray<FName> ToAdd;
+		TArray<FName> ToRemove;
+		bool bCreate = false;
+	};
+	TArray<FPendingCollection> PendingCollections;
+	TSet<FName> DesiredNames;
+
+	for (int32 URLId = 0; URLId < AssetsByURLId.Num(); ++URLId)
+	{
+		TArray<FName>& DesiredAssets = AssetsByURLId[URLId];
+		if (DesiredAssets.Num() == 0)
+		{
+			continue;
+		}
+
+		FPendingCollection Pending;
+		Pending.Name = MakeCollectionName(Index.GetURL(URLId), URLData.LicenseAsset[URLId]);
+		DesiredNames.Add(Pending.Name);
+
+		if (CollectionManager.CollectionExists(Pending.Name, ShareType))
+		{
+			TArray<FName> ExistingAssets;
+			CollectionManager.GetObjectsInCollection(Pending.Name, ShareType, /*out*/ ExistingAssets, ECollectionRecursionFlags::Self);
+
+			const TSet<FName> ExistingSet(ExistingAssets);
+			const TSet<FName> DesiredSet(DesiredAssets);
+			for (FName Asset : DesiredAssets)
+			{
+				if (!ExistingSet.Contains(Asset))
+				{
+					Pending.ToAdd.Add(Asset);
+				}
+			}
+			for (FName Asset : ExistingAssets)
+			{
+				if (!DesiredSet.Contains(Asset))
+				{
+					Pending.ToRemove.Add(Asset);
+				}
+			}
+		}
+		else
+		{
+			Pending.bCreate = true;
+			Pending.ToAdd = MoveTemp(DesiredAssets);
+		}
+
+		if (Pending.bCreate || (Pending.ToAdd.Num() > 0) || (Pending.ToRemove.Num() > 0))
+		{
+			PendingCollections.Add(MoveTemp(Pending));
+		}
+	}
+
+	// Collections for URLs that no longer have any assets (leaving alone anything the user parented here by hand)
+	TArray<FName> ObsoleteNames;
+	if (CollectionManager.CollectionExists(ParentName, ShareType))
+	{
+		TArray<FName> ExistingChildren;
+		CollectionManager.GetChildCollectionNames(ParentName, ShareType, ShareType, /*out*/ ExistingChildren);
+		for (FName ChildName : ExistingChildren)
+		{
+			if (!DesiredNames.Contains(ChildName) && IsGeneratedCollectionName(ChildName))
+			{
+				ObsoleteNames.Add(ChildName);
+			}
+		}
+	}
+
+	if ((PendingCollections.Num() == 0) && (ObsoleteNames.Num() == 0))
+	{
+		FNotificationInfo Info(LOCTEXT("LicenseCollectionsUpToDate", "License collections are already up to date"));
+		Info.ExpireDuration = 3.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return;
+	}
+
+	FScopedSlowTask SlowTask((float)(PendingCollections.Num() + ObsoleteNames.Num()), LOCTEXT("RefreshingLicenseCollections", "Refreshing license collections..."));
+	SlowTask.MakeDialogDelayed(0.5f);
+
+	// Check out every existing collection file that is about to change in a single operation
+	if ((ShareType != ECollectionShareType::CST_Local) && ISourceControlModule::Get().IsEnabled())
+	{
+		TArray<FString> FilesToCheckOut;
+		for (const FPendingCollection& Pending : PendingCollections)
+		{
+			if (!Pending.bCreate)
+			{
+				FilesToCheckOut.Add(FPaths::ConvertRelativePathToFull(CollectionDir / Pending.Name.ToString() + TEXT(".collection")));
+			}
+		}
+		for (FName ObsoleteName : ObsoleteNames)
+		{
+			FilesToCheckOut.Add(FPaths::ConvertRelativePathToFull(CollectionDir / ObsoleteName.ToString() + TEXT(".collection")));
+		}
+
+		if (FilesToCheckOut.Num() > 0)
+		{
+			ISourceControlModule::Get().GetProvider().Execute(ISourceControlOperation::Create<FCheckOut>(), FilesToCheckOut);
+		}
+	}
+
+	if (!CollectionManager.CollectionExists(ParentName, ShareType))
+	{
+		CollectionManager.CreateCollection(ParentName, ShareType, ECollectionStorageMode::Static);
+	}
+
+	int32 NumFailed = 0;
+	for (const FPendingCollection& Pending : PendingCollections)
+	{
+		SlowTask.EnterProgressFrame();
+
+		if (Pending.bCreate)
+		{
+			if (!CollectionManager.CreateCollection(Pending.Name, ShareType, ECollectionStorageMode::Static) ||
+				!CollectionManager.ReparentCollection(Pending.Name, ShareType, ParentName, ShareType))
+			{
+				UE_LOG(LogJamLicenseTracker, Warning, TEXT("Failed to create collection %s: %s"), *Pending.Name.ToString(), *CollectionManager.GetLastError().ToString());
+				++NumFailed;
+				continue;
+			}
+		}
+
+		if (Pending.ToRemove.Num() > 0)
+		{
+			CollectionManager.RemoveFromCollection(Pending.Name, ShareType, Pending.ToRemove);
+		}
+		if (Pending.ToAdd.Num() > 0)
+		{
+			CollectionManager.AddToCollection(Pending.Name, ShareType, Pending.ToAdd);
+		}
+	}
+
+	for (FName ObsoleteName : ObsoleteNames)
+	{
+		SlowTask.EnterProgressFrame();
+		CollectionManager.DestroyCollection(ObsoleteName, ShareType);
+	}
+
+	FNotificationInfo Info(FText::Format(LOCTEXT("RefreshedLicenseCollections", "Updated {0} license {0}|plural(one=collection,other=collections) ({1} removed, {2} failed)"),
+		FText::AsNumber(PendingCollections.Num() - NumFailed), FText::AsNumber(ObsoleteNames.Num()), FText::AsNumber(NumFailed)));
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,50 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Content Browser collection helpers for license tracking
+class FJamLicenseCollections
+{
+public:
+	// Name of the local collection used to show large Select Associated Assets results
+	static const FName AssociatedAssetsCollectionName;
+
+	// Replaces the contents of the local associated assets collection and opens an asset picker on it.
+	// The asset picker filters its view incrementally over several frames, so unlike SyncBrowserToAssets
+	// this returns immediately even for tens of thousands of assets
+	static void ShowInAssociatedAssetsCollection(const TArray<FName>& ObjectPaths);
+
+	// Creates or refreshes one collection per source URL (named after its license asset when there is one),
+	// all parented under the collection named in the plugin settings
+	//
+	// The desired contents come from FJamLicenseIndex in a single pass and are diffed against what the
+	// collections already hold, so only collections whose assignments changed are written. For source
+	// controlled share types, every affected collection file is checked out in one operation up front
+	static void RefreshLicenseCollections();
+
+private:
+	static FName MakeCollectionName(const FString& URL, FName LicenseAsset);
+
+	// Does the name have the <base>_XXXXXXXX form produced by MakeCollectionName?
+	static bool IsGeneratedCollectionName(FName Name);
+};
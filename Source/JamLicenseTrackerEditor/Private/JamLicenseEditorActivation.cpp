@@ -0,0 +1,184 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseEditorActivation.h"
+
+#include "JamLicenseBudget.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseSelectionPrefetcher.h"
+#include "JamLicenseTagBackfill.h"
+#include "JamLicenseTrackerLog.h"
+#include "JamLicenseTrackerSettings.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "IAssetRegistry.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
+
+bool FJamLicenseEditorActivation::bEnabled = false;
+bool FJamLicenseEditorActivation::bActivationStarted = false;
+bool FJamLicenseEditorActivation::bActivated = false;
+FTSTicker::FDelegateHandle FJamLicenseEditorActivation::IdleTickerHandle;
+FSimpleMulticastDelegate FJamLicenseEditorActivation::ActivatedEvent;
+
+void FJamLicenseEditorActivation::Initialize()
+{
+	bEnabled = true;
+
+	if (GetDefault<UJamLicenseTrackerSettings>()->ActivationIdleSeconds <= 0.0f)
+	{
+		StartActivation();
+	}
+	else
+	{
+		IdleTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FJamLicenseEditorActivation::TickIdleActivation), /*InDelay=*/ 0.5f);
+	}
+}
+
+void FJamLicenseEditorActivation::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(IdleTickerHandle);
+	IdleTickerHandle.Reset();
+
+	if (bActivationStarted)
+	{
+		FJamLicenseTagBackfill::Shutdown();
+		FJamLicenseSelectionPrefetcher::Shutdown();
+		FJamLicenseIndex::Shutdown();
+	}
+
+	ActivatedEvent.Clear();
+	bActivated = false;
+	bActivationStarted = false;
+	bEnabled = false;
+}
+
+bool FJamLicenseEditorActivation::EnsureActivated()
+{
+	if (bEnabled && !bActivated)
+	{
+		check(IsInGameThread());
+		if (!bActivationStarted)
+		{
+			StartActivation();
+		}
+		FJamLicenseIndex::Get().FinishBuild();
+	}
+	return FJamLicenseIndex::IsAvailable();
+}
+
+bool FJamLicenseEditorActivation::RequestActivation()
+{
+	if (bEnabled && !bActivationStarted)
+	{
+		check(IsInGameThread());
+		StartActivation();
+	}
+	return FJamLicenseIndex::IsAvailable();
+}
+
+FText FJamLicenseEditorActivation::GetBuildingText()
+{
+	const float Progress = FJamLicenseIndex::IsBuilding() ? FJamLicenseIndex::Get().GetBuildProgress() : 0.0f;
+	return FText::Format(LOCTEXT("BuildingLicenseIndex", "Building the license index ({0})..."), FText::AsPercent(Progress));
+}
+
+TSharedRef<SWidget> FJamLicenseEditorActivation::MakeWidgetWhenActivated(TFunction<TSharedRef<SWidget>()> MakeWidget)
+{
+	if (RequestActivation())
+	{
+		return MakeWidget();
+	}
+
+	TSharedRef<SBox> Placeholder = SNew(SBox)
+		.HAlign(HAlign_Center)
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text_Static(&FJamLicenseEditorActivation::GetBuildingText)
+		];
+
+	ActivatedEvent.AddLambda([WeakPlaceholder = TWeakPtr<SBox>(Placeholder), MakeWidget = MoveTemp(MakeWidget)]()
+	{
+		if (TSharedPtr<SBox> PinnedPlaceholder = WeakPlaceholder.Pin())
+		{
+			PinnedPlaceholder->SetHAlign(HAlign_Fill);
+			PinnedPlaceholder->SetVAlign(VAlign_Fill);
+			PinnedPlaceholder->SetContent(MakeWidget());
+		}
+	});
+
+	return Placeholder;
+}
+
+void FJamLicenseEditorActivation::StartActivation()
+{
+	FJamLicenseBudgetScope BudgetScope(TEXT("Activate"));
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	bActivationStarted = true;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(IdleTickerHandle);
+	IdleTickerHandle.Reset();
+
+	// Only the registry snapshot is taken here, the tables are filled in a few milliseconds per tick
+	FJamLicenseIndex::Initialize(/*bTimeSliced=*/ true);
+	FJamLicenseIndex::Get().OnBuildFinished().AddStatic(&FJamLicenseEditorActivation::OnIndexBuilt);
+}
+
+void FJamLicenseEditorActivation::OnIndexBuilt()
+{
+	FJamLicenseBudgetScope BudgetScope(TEXT("FinishActivation"));
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	bActivated = true;
+
+	FJamLicenseSelectionPrefetcher::Initialize();
+	FJamLicenseTagBackfill::Initialize();
+
+	ActivatedEvent.Broadcast();
+
+	UE_LOG(LogJamLicenseTracker, Verbose, TEXT("License tracker activated (index built in %.2f ms of game thread time)"), FJamLicenseIndex::Get().GetBuildSeconds() * 1000.0);
+}
+
+bool FJamLicenseEditorActivation::TickIdleActivation(float DeltaTime)
+{
+	// Building the index in one pass after the initial scan is much cheaper than following every asset added event during it
+	if (IAssetRegistry::GetChecked().IsLoadingAssets())
+	{
+		return true;
+	}
+
+	// Don't compete with whatever the user is doing right after boot
+	const double IdleSeconds = FSlateApplication::IsInitialized() ? (FPlatformTime::Seconds() - FSlateApplication::Get().GetLastUserInteractionTime()) : 0.0;
+	if (IdleSeconds < GetDefault<UJamLicenseTrackerSettings>()->ActivationIdleSeconds)
+	{
+		return true;
+	}
+
+	IdleTickerHandle.Reset();
+	StartActivation();
+	return false;
+}
+
+#undef LOCTEXT_NAMESPACE
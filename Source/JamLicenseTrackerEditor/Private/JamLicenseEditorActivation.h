@@ -0,0 +1,81 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class SWidget;
+
+// Defers the expensive parts of the editor module until a license feature is first used, or until the editor has
+// finished its initial asset scan and the user has been idle for a moment (ActivationIdleSeconds in the settings)
+//
+// Startup only registers stubs (menu extensions, tab spawners, console commands, badge generators) that call
+// RequestActivation or EnsureActivated before touching the license index. Activation starts a time-sliced build of
+// the index; once that finishes it starts the selection prefetcher and the registry tag backfill, then broadcasts
+// OnActivated for anything else that was deferred.
+class FJamLicenseEditorActivation
+{
+public:
+	// Enables deferred activation for this (interactive) editor session
+	static void Initialize();
+	static void Shutdown();
+
+	// Activates now if that hasn't happened yet and finishes building the index if it's still in progress, returning
+	// true if the license index is available (game thread only, meant for console commands and actions that can't wait)
+	//
+	// Outside of interactive sessions this never activates anything, and only reports whether something else
+	// (e.g., a commandlet) created the index
+	static bool EnsureActivated();
+
+	// Starts activating if that hasn't happened yet without waiting for the index, returning true if it is already
+	// available (menu builders and tab spawners should show GetBuildingText() instead of license data until then)
+	static bool RequestActivation();
+
+	// Returns true once the index has been built and everything deferred has been set up
+	static bool IsActivated()
+	{
+		return bActivated;
+	}
+
+	// Broadcast once the index has been built and everything deferred has been set up
+	static FSimpleMulticastDelegate& OnActivated()
+	{
+		return ActivatedEvent;
+	}
+
+	// Describes the progress of the index build, for menu entries and placeholders
+	static FText GetBuildingText();
+
+	// Returns the widget made by MakeWidget if the index is available, otherwise a placeholder that is replaced by it once activated
+	static TSharedRef<SWidget> MakeWidgetWhenActivated(TFunction<TSharedRef<SWidget>()> MakeWidget);
+
+private:
+	static void StartActivation();
+	static void OnIndexBuilt();
+	static bool TickIdleActivation(float DeltaTime);
+
+	static bool bEnabled;
+	static bool bActivationStarted;
+	static bool bActivated;
+	static FTSTicker::FDelegateHandle IdleTickerHandle;
+	static FSimpleMulticastDelegate ActivatedEvent;
+};
@@ -0,0 +1,219 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseEditorBenchmark.h"
+
+#include "JamLicenseAssociatedAssets.h"
+#include "JamLicenseBenchmark.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseManifest.h"
+#include "JamLicenseManifestHarvester.h"
+#include "JamLicenseSelectionPrefetcher.h"
+#include "JamLicenseStateBadges.h"
+
+#include "AssetData.h"
+#include "HAL/FileManager.h"
+#include "IAssetRegistry.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+
+bool FJamLicenseEditorBenchmark::Run(FJamLicenseBenchmarkReport& OutReport, FString& OutError) const
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	const int32 NumSlowIterations = FMath::Clamp(NumIterations / 4, 1, 5);
+
+	TArray<FAssetData> AllAssets;
+	IAssetRegistry::GetChecked().GetAllAssets(/*out*/ AllAssets);
+	if (AllAssets.Num() == 0)
+	{
+		OutError = TEXT("The asset registry is empty, there is nothing to benchmark");
+		return false;
+	}
+
+	// Inputs are picked up front (with a fixed seed) so they're the same from run to run and aren't part of the timings
+	FRandomStream Random(1);
+	const int32 NumSelected = FMath::Clamp(SelectionSize, 1, AllAssets.Num());
+
+	TArray<TArray<FAssetData>> Selections;
+	Selections.SetNum(NumIterations);
+	for (TArray<FAssetData>& Selection : Selections)
+	{
+		Selection.Reserve(NumSelected);
+		for (int32 PickIndex = 0; PickIndex < NumSelected; ++PickIndex)
+		{
+			Selection.Add(AllAssets[Random.RandHelper(AllAssets.Num())]);
+		}
+	}
+
+	TArray<FString> LicensedURLs;
+	for (int32 URLId = 0; URLId < Index.GetNumURLIds(); ++URLId)
+	{
+		if (Index.HasLicenseAsset(URLId) && (Index.GetNumAssetsUsingURL(URLId) > 0))
+		{
+			LicensedURLs.Add(Index.GetURL(URLId));
+		}
+	}
+
+	OutReport.Context.Add(TEXT("project"), FApp::GetProjectName());
+	OutReport.Context.Add(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	OutReport.Context.Add(TEXT("assets"), LexToString(AllAssets.Num()));
+	OutReport.Context.Add(TEXT("assetsWithURL"), LexToString(Index.GetAssetURLIds().Num()));
+	OutReport.Context.Add(TEXT("licensedURLs"), LexToString(LicensedURLs.Num()));
+	OutReport.Context.Add(TEXT("selectionSize"), LexToString(NumSelected));
+
+	if (bIncludeFullRebuilds)
+	{
+		OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("IndexBuild"), NumSlowIterations, [](int32)
+		{
+			FJamLicenseIndex ScratchIndex;
+		}));
+	}
+
+	// Accumulated so the lookups can't be optimized away
+	int64 NumLicensedLookups = 0;
+	OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("IndexLookup"), NumIterations, [&Selections, &Index, &NumLicensedLookups](int32 Iteration)
+	{
+		for (const FAssetData& AssetData : Selections[FMath::Max(Iteration, 0)])
+		{
+			NumLicensedLookups += (Index.GetAssetState(AssetData.ObjectPath) == EJamLicenseState::Licensed) ? 1 : 0;
+		}
+	}, NumSelected));
+
+	// Each sample is one repaint, evaluating the badge attributes of every visible tile the way Slate does while painting
+	// (the dot itself is one more draw element batched with the rest of the tile, which isn't measurable without a renderer)
+	const int32 NumBadges = FMath::Clamp(BadgesPerRepaint, 1, AllAssets.Num());
+	TArray<FJamLicenseStateBadgeCache> Badges;
+	Badges.Reserve(NumBadges);
+	for (int32 BadgeIndex = 0; BadgeIndex < NumBadges; ++BadgeIndex)
+	{
+		Badges.Emplace(AllAssets[Random.RandHelper(AllAssets.Num())].ObjectPath);
+	}
+	OutReport.Context.Add(TEXT("badgesPerRepaint"), LexToString(NumBadges));
+	OutReport.Context.Add(TEXT("badgeRepaintBudgetMs"), LexToString(BadgeRepaintBudgetMs));
+
+	auto PaintBadges = [&NumLicensedLookups](const TArray<FJamLicenseStateBadgeCache>& BadgesToPaint)
+	{
+		for (const FJamLicenseStateBadgeCache& Badge : BadgesToPaint)
+		{
+			NumLicensedLookups += (FJamLicenseStateBadgeCache::AreBadgesShown() && (Badge.GetState() == EJamLicenseState::Licensed)) ? 1 : 0;
+		}
+	};
+
+	// Unpainted copies behave like every tile right after the index version changes, each one looks its state up again
+	// (made up front, with one extra set for the warm-up call, so only the repaint is timed)
+	TArray<TArray<FJamLicenseStateBadgeCache>> StaleBadgeSets;
+	StaleBadgeSets.Init(Badges, NumIterations + 1);
+
+	OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("BadgePaint"), NumIterations, [&Badges, &PaintBadges](int32)
+	{
+		PaintBadges(Badges);
+	}, NumBadges));
+
+	OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("BadgeRefresh"), NumIterations, [&StaleBadgeSets, &PaintBadges](int32 Iteration)
+	{
+		PaintBadges(StaleBadgeSets[Iteration + 1]);
+	}, NumBadges));
+
+	OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("MenuState"), NumIterations, [&Selections](int32 Iteration)
+	{
+		const std::atomic<bool> bNeverCancelled(false);
+		FJamLicenseSelectionPrefetcher::ComputeFromAssetData(Selections[FMath::Max(Iteration, 0)], bNeverCancelled);
+	}, NumSelected));
+
+	if (LicensedURLs.Num() > 0)
+	{
+		OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("AssociatedAssets"), NumIterations, [&LicensedURLs](int32 Iteration)
+		{
+			TArray<FAssetData> Matches;
+			FJamLicenseAssociatedAssets::FindMatching({ LicensedURLs[FMath::Max(Iteration, 0) % LicensedURLs.Num()] }, /*out*/ Matches);
+		}));
+	}
+
+	FJamLicenseManifest Manifest;
+	auto HarvestManifest = [&Manifest](int32)
+	{
+		TArray<FJamLicenseManifestCultureSection> CultureSections;
+		FJamLicenseManifestHarvester::Harvest(/*out*/ Manifest, /*out*/ CultureSections);
+	};
+
+	if (bIncludeFullRebuilds)
+	{
+		OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("Audit"), NumSlowIterations, HarvestManifest));
+	}
+	else
+	{
+		// Still needed as the input for the manifest benchmarks
+		HarvestManifest(-1);
+	}
+
+	const FString ScratchManifestFilename = FPaths::ProjectSavedDir() / TEXT("JamLicenseTracker") / TEXT("Benchmarks") / TEXT("ScratchManifest.json");
+	if (Manifest.SaveToFile(ScratchManifestFilename))
+	{
+		OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("ManifestLoad"), NumIterations, [&ScratchManifestFilename](int32)
+		{
+			FJamLicenseManifest Loaded;
+			FString Error;
+			Loaded.LoadFromFile(ScratchManifestFilename, /*out*/ Error);
+		}));
+		IFileManager::Get().Delete(*ScratchManifestFilename);
+	}
+
+	if (Manifest.Licenses.Num() > 0)
+	{
+		const int32 QueriesPerSample = 10000;
+		TArray<FString> QueryURLs;
+		QueryURLs.Reserve(QueriesPerSample);
+		for (int32 QueryIndex = 0; QueryIndex < QueriesPerSample; ++QueryIndex)
+		{
+			QueryURLs.Add(Manifest.Licenses[Random.RandHelper(Manifest.Licenses.Num())].AssetSourceURL);
+		}
+
+		OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("RuntimeQuery"), NumIterations, [&Manifest, &QueryURLs](int32)
+		{
+			int32 NumFound = 0;
+			for (const FString& URL : QueryURLs)
+			{
+				NumFound += (Manifest.FindByURL(URL) != nullptr) ? 1 : 0;
+			}
+			check(NumFound == QueryURLs.Num());
+		}, QueriesPerSample));
+	}
+
+	OutReport.AddPeakMemoryToContext();
+	return true;
+}
+
+TArray<FString> FJamLicenseEditorBenchmark::FindBudgetOverruns(const FJamLicenseBenchmarkReport& Report)
+{
+	TArray<FString> Overruns;
+
+	// The 90th percentile, a budget only met by the median would still drop frames regularly
+	for (const TCHAR* BadgeResultName : { TEXT("BadgePaint"), TEXT("BadgeRefresh") })
+	{
+		const FJamLicenseBenchmarkResult* Result = Report.FindResult(BadgeResultName);
+		if ((Result != nullptr) && (Result->P90Ms > BadgeRepaintBudgetMs))
+		{
+			Overruns.Add(FString::Printf(TEXT("%s: %.4f ms per repaint of %lld tiles (p90) is over the %.2f ms budget (%.2f us per badge)"),
+				BadgeResultName, Result->P90Ms, Result->OperationsPerSample, BadgeRepaintBudgetMs, Result->P90Ms * 1000.0 / (double)FMath::Max<int64>(Result->OperationsPerSample, 1)));
+		}
+	}
+
+	return Overruns;
+}
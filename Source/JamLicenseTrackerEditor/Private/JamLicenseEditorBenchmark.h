@@ -0,0 +1,56 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FJamLicenseBenchmarkReport;
+
+// The editor license benchmarks, shared by the JamLicenseBenchmark commandlet and the JamLicense.Bench console command
+//
+// Times IndexBuild, IndexLookup (license state of a selection), MenuState (selection summary from tags),
+// AssociatedAssets (Select Associated Assets matching), Audit (manifest harvest), ManifestLoad, RuntimeQuery
+// (batches of manifest lookups by URL), and BadgePaint / BadgeRefresh (what the license state badges add to one
+// Content Browser repaint, normally and right after the index changed) against the current asset registry
+struct FJamLicenseEditorBenchmark
+{
+	// Timed samples per benchmark (IndexBuild and Audit use fewer, they are much slower)
+	int32 NumIterations = 20;
+
+	// Number of assets in each simulated Content Browser selection
+	int32 SelectionSize = 1000;
+
+	// Number of asset tiles in a simulated Content Browser repaint (about a maximized view with the smallest thumbnails)
+	int32 BadgesPerRepaint = 500;
+
+	// Include IndexBuild and Audit, which walk the whole project and can take seconds each
+	bool bIncludeFullRebuilds = true;
+
+	// The most the license state badges may add to a full Content Browser repaint
+	static constexpr double BadgeRepaintBudgetMs = 0.1;
+
+public:
+	// Requires FJamLicenseIndex to be available
+	bool Run(FJamLicenseBenchmarkReport& OutReport, FString& OutError) const;
+
+	// Returns a description of every result in the report that is over its fixed budget (independent of any baseline)
+	static TArray<FString> FindBudgetOverruns(const FJamLicenseBenchmarkReport& Report);
+};
@@ -0,0 +1,177 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseEditorDiagnostics.h"
+
+#include "JamLicenseDiagnostics.h"
+#include "JamLicenseEditorActivation.h"
+#include "JamLicenseEditorBenchmark.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseSelectionSummary.h"
+
+namespace JamLicenseEditorDiagnostics
+{
+	// Dumping a short prefix (or nothing) on a big project could otherwise print hundreds of thousands of lines
+	static const int32 MaxAssetsPerURL = 50;
+
+	class FIndexDiagnostics : public IJamLicenseDiagnostics
+	{
+	public:
+		//~IJamLicenseDiagnostics interface
+		virtual const TCHAR* GetDiagnosticsName() const override
+		{
+			return TEXT("Index");
+		}
+
+		virtual void PrintStats(FOutputDevice& Ar) const override
+		{
+			if (!FJamLicenseEditorActivation::EnsureActivated())
+			{
+				Ar.Logf(TEXT("  No license index in this session"));
+				return;
+			}
+
+			FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+
+			int32 NumURLsInUse = 0;
+			int32 NumLicensedURLs = 0;
+			for (int32 URLId = 0; URLId < Index.GetNumURLIds(); ++URLId)
+			{
+				if (Index.GetNumAssetsUsingURL(URLId) > 0)
+				{
+					++NumURLsInUse;
+					NumLicensedURLs += Index.HasLicenseAsset(URLId) ? 1 : 0;
+				}
+			}
+
+			FJamLicenseMemoryUsage Usage;
+			Index.GetMemoryUsage(/*inout*/ Usage);
+			FJamLicenseSelectionCache::GetMemoryUsage(/*inout*/ Usage);
+
+			Ar.Logf(TEXT("  Version:          %u"), Index.GetVersion());
+			Ar.Logf(TEXT("  URLs:             %d in use (%d licensed), %d ids handed out"), NumURLsInUse, NumLicensedURLs, Index.GetNumURLIds());
+			Ar.Logf(TEXT("  Assets with URL:  %d"), Index.GetAssetURLIds().Num());
+			Ar.Logf(TEXT("  License assets:   %d"), Index.GetNumLicenseAssets());
+			Ar.Logf(TEXT("  Folders:          %d"), Index.GetFolderCoverage().GetNumFolders());
+			Ar.Logf(TEXT("  Build time:       %.2f ms"), Index.GetBuildSeconds() * 1000.0);
+			Ar.Logf(TEXT("  Memory:           %.1f KB"), (double)Usage.GetTotal() / 1024.0);
+			Ar.Logf(TEXT("  Sort data:        %s"), *Index.GetURLSortDataCounter().ToString());
+			Ar.Logf(TEXT("  Folder stats:     %s"), *Index.GetFolderCoverage().GetStatsCacheCounter().ToString());
+			Ar.Logf(TEXT("  Menu selections:  %s"), *FJamLicenseSelectionCache::GetCounter().ToString());
+		}
+
+		virtual void Dump(const FString& URLPrefix, FOutputDevice& Ar) const override
+		{
+			if (!FJamLicenseEditorActivation::EnsureActivated())
+			{
+				return;
+			}
+
+			FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+			const FJamLicenseURLSortData& SortData = Index.GetURLSortData();
+
+			TMap<int32, TArray<FName>> AssetsByURLId;
+			for (const TPair<FName, int32>& Pair : Index.GetAssetURLIds())
+			{
+				if (Index.GetURL(Pair.Value).StartsWith(URLPrefix))
+				{
+					AssetsByURLId.FindOrAdd(Pair.Value).Add(Pair.Key);
+				}
+			}
+			AssetsByURLId.KeySort([&Index](int32 A, int32 B) { return Index.GetURL(A) < Index.GetURL(B); });
+
+			for (TPair<int32, TArray<FName>>& Pair : AssetsByURLId)
+			{
+				const int32 URLId = Pair.Key;
+				TArray<FName>& Assets = Pair.Value;
+				Assets.Sort(FNameLexicalLess());
+
+				Ar.Logf(TEXT("  [%d] %s"), URLId, *Index.GetURL(URLId));
+				Ar.Logf(TEXT("    License: %s, %d assets"), Index.HasLicenseAsset(URLId) ? *SortData.LicenseAsset[URLId].ToString() : TEXT("none"), Index.GetNumAssetsUsingURL(URLId));
+				for (int32 AssetIndex = 0; AssetIndex < FMath::Min(Assets.Num(), MaxAssetsPerURL); ++AssetIndex)
+				{
+					Ar.Logf(TEXT("      %s"), *Assets[AssetIndex].ToString());
+				}
+				if (Assets.Num() > MaxAssetsPerURL)
+				{
+					Ar.Logf(TEXT("      ... and %d more"), Assets.Num() - MaxAssetsPerURL);
+				}
+			}
+		}
+
+		virtual void Rebuild(FOutputDevice& Ar) override
+		{
+			if (FJamLicenseEditorActivation::EnsureActivated())
+			{
+				FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+				Index.Rebuild();
+				FJamLicenseSelectionCache::Reset();
+				Ar.Logf(TEXT("[%s] Rebuilt in %.2f ms"), GetDiagnosticsName(), Index.GetBuildSeconds() * 1000.0);
+			}
+		}
+
+		virtual void Bench(FJamLicenseBenchmarkReport& Report, FOutputDevice& Ar) override
+		{
+			if (!FJamLicenseEditorActivation::EnsureActivated())
+			{
+				return;
+			}
+
+			// Fewer samples than the JamLicenseBenchmark commandlet, so the editor isn't frozen for long
+			FJamLicenseEditorBenchmark Benchmark;
+			Benchmark.NumIterations = 5;
+
+			FString Error;
+			if (!Benchmark.Run(/*out*/ Report, /*out*/ Error))
+			{
+				Ar.Logf(TEXT("[%s] %s"), GetDiagnosticsName(), *Error);
+				return;
+			}
+
+			for (const FString& Overrun : FJamLicenseEditorBenchmark::FindBudgetOverruns(Report))
+			{
+				Ar.Logf(ELogVerbosity::Warning, TEXT("[%s] %s"), GetDiagnosticsName(), *Overrun);
+			}
+		}
+		//~End of IJamLicenseDiagnostics interface
+	};
+
+	static TUniquePtr<FIndexDiagnostics> IndexDiagnostics;
+}
+
+void FJamLicenseEditorDiagnostics::Initialize()
+{
+	using namespace JamLicenseEditorDiagnostics;
+
+	IndexDiagnostics = MakeUnique<FIndexDiagnostics>();
+	IJamLicenseDiagnostics::Register(IndexDiagnostics.Get());
+}
+
+void FJamLicenseEditorDiagnostics::Shutdown()
+{
+	using namespace JamLicenseEditorDiagnostics;
+
+	if (IndexDiagnostics.IsValid())
+	{
+		IJamLicenseDiagnostics::Unregister(IndexDiagnostics.Get());
+		IndexDiagnostics.Reset();
+	}
+}
@@ -0,0 +1,163 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseFolderCoverage.h"
+
+FJamLicenseFolderCoverage::FFolderEntry& FJamLicenseFolderCoverage::FindOrAddFolder(FName FolderPath)
+{
+	if (FFolderEntry* Existing = Folders.Find(FolderPath))
+	{
+		return *Existing;
+	}
+
+	// Only new folders pay for working out their parent
+	FName ParentPath;
+	FString PathString = FolderPath.ToString();
+	int32 LastSlash = INDEX_NONE;
+	if (PathString.FindLastChar(TEXT('/'), /*out*/ LastSlash) && (LastSlash > 0))
+	{
+		ParentPath = FName(*PathString.Left(LastSlash));
+	}
+
+	if (!ParentPath.IsNone())
+	{
+		FindOrAddFolder(ParentPath).Children.Add(FolderPath);
+	}
+
+	FFolderEntry& NewEntry = Folders.Add(FolderPath);
+	NewEntry.Parent = ParentPath;
+	return NewEntry;
+}
+
+void FJamLicenseFolderCoverage::AddAsset(FName PackagePath, int32 URLId, int32 Delta)
+{
+	if (PackagePath.IsNone())
+	{
+		return;
+	}
+
+	ForEachFolderInChain(PackagePath, [URLId, Delta](FFolderEntry& Entry)
+	{
+		Entry.NumAssets += Delta;
+		if (URLId != INDEX_NONE)
+		{
+			Entry.NumAssetsWithURL += Delta;
+
+			int32& Count = Entry.AssetsPerURL.FindOrAdd(URLId);
+			Count += Delta;
+			if (Count <= 0)
+			{
+				Entry.AssetsPerURL.Remove(URLId);
+			}
+		}
+		Entry.CachedVersion = 0;
+	});
+}
+
+void FJamLicenseFolderCoverage::ChangeAssetURL(FName PackagePath, int32 OldURLId, int32 NewURLId)
+{
+	if (PackagePath.IsNone() || (OldURLId == NewURLId))
+	{
+		return;
+	}
+
+	ForEachFolderInChain(PackagePath, [OldURLId, NewURLId](FFolderEntry& Entry)
+	{
+		if (OldURLId != INDEX_NONE)
+		{
+			--Entry.NumAssetsWithURL;
+			int32& Count = Entry.AssetsPerURL.FindOrAdd(OldURLId);
+			if (--Count <= 0)
+			{
+				Entry.AssetsPerURL.Remove(OldURLId);
+			}
+		}
+
+		if (NewURLId != INDEX_NONE)
+		{
+			++Entry.NumAssetsWithURL;
+			Entry.AssetsPerURL.FindOrAdd(NewURLId) += 1;
+		}
+		Entry.CachedVersion = 0;
+	});
+}
+
+FJamLicenseFolderStats FJamLicenseFolderCoverage::GetStats(FName FolderPath, uint32 IndexVersion, TFunctionRef<bool(int32)> HasLicenseAsset) const
+{
+	FJamLicenseFolderStats Result;
+
+	if (const FFolderEntry* Entry = Folders.Find(FolderPath))
+	{
+		StatsCacheCounter.Record(Entry->CachedVersion == IndexVersion);
+		if (Entry->CachedVersion != IndexVersion)
+		{
+			Entry->CachedNumAssetsWithLicense = 0;
+			for (const TPair<int32, int32>& Pair : Entry->AssetsPerURL)
+			{
+				if (HasLicenseAsset(Pair.Key))
+				{
+					Entry->CachedNumAssetsWithLicense += Pair.Value;
+				}
+			}
+			Entry->CachedVersion = IndexVersion;
+		}
+
+		Result.NumAssets = Entry->NumAssets;
+		Result.NumAssetsWithURL = Entry->NumAssetsWithURL;
+		Result.NumAssetsWithLicense = Entry->CachedNumAssetsWithLicense;
+		Result.NumDistinctURLs = Entry->AssetsPerURL.Num();
+	}
+
+	return Result;
+}
+
+void FJamLicenseFolderCoverage::GetChildFolders(FName FolderPath, TArray<FName>& OutChildren) const
+{
+	if (const FFolderEntry* Entry = Folders.Find(FolderPath))
+	{
+		OutChildren.Append(Entry->Children);
+	}
+}
+
+void FJamLicenseFolderCoverage::GetRootFolders(TArray<FName>& OutRoots) const
+{
+	for (const TPair<FName, FFolderEntry>& Pair : Folders)
+	{
+		if (Pair.Value.Parent.IsNone())
+		{
+			OutRoots.Add(Pair.Key);
+		}
+	}
+}
+
+void FJamLicenseFolderCoverage::Reset()
+{
+	Folders.Reset();
+}
+
+SIZE_T FJamLicenseFolderCoverage::GetAllocatedSize() const
+{
+	SIZE_T Size = Folders.GetAllocatedSize();
+	for (const TPair<FName, FFolderEntry>& Pair : Folders)
+	{
+		Size += Pair.Value.Children.GetAllocatedSize() + Pair.Value.AssetsPerURL.GetAllocatedSize();
+	}
+	return Size;
+}
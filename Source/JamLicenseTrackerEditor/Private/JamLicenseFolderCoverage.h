@@ -0,0 +1,112 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JamLicenseDiagnostics.h"
+
+// License coverage totals for one content folder, including everything below it
+struct FJamLicenseFolderStats
+{
+	int32 NumAssets = 0;
+	int32 NumAssetsWithURL = 0;
+	int32 NumAssetsWithLicense = 0;
+	int32 NumDistinctURLs = 0;
+
+	// Fraction of all assets in the folder that have a source URL with a license asset
+	float GetCoverage() const
+	{
+		return (NumAssets > 0) ? ((float)NumAssetsWithLicense / (float)NumAssets) : 1.0f;
+	}
+};
+
+// Per-folder rollups of license coverage, kept up to date along the ancestor chain of each changed asset
+// (so one tag change touches a handful of folders rather than the whole tree)
+//
+// Each folder stores how many assets below it use each URL id. Whether a URL has a license asset can change
+// independently of the folder, so the licensed count is derived from those per-URL counts on demand and
+// cached against the index version.
+class FJamLicenseFolderCoverage
+{
+public:
+	// Adds (Delta = 1) or removes (Delta = -1) an asset from the totals of its folder and all ancestors
+	void AddAsset(FName PackagePath, int32 URLId, int32 Delta);
+
+	// Moves an asset from one URL id (or INDEX_NONE) to another
+	void ChangeAssetURL(FName PackagePath, int32 OldURLId, int32 NewURLId);
+
+	// Returns the totals for a folder (e.g., /Game/Characters), evaluating license state with the provided function
+	FJamLicenseFolderStats GetStats(FName FolderPath, uint32 IndexVersion, TFunctionRef<bool(int32)> HasLicenseAsset) const;
+
+	// Returns the immediate child folders that contain (or used to contain) assets
+	void GetChildFolders(FName FolderPath, TArray<FName>& OutChildren) const;
+
+	// Returns the mount point folders (e.g., /Game)
+	void GetRootFolders(TArray<FName>& OutRoots) const;
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+	int32 GetNumFolders() const
+	{
+		return Folders.Num();
+	}
+
+	// Hits are GetStats calls that reused the licensed count cached for the current index version
+	const FJamLicenseCacheCounter& GetStatsCacheCounter() const
+	{
+		return StatsCacheCounter;
+	}
+
+private:
+	struct FFolderEntry
+	{
+		FName Parent;
+		TArray<FName> Children;
+		int32 NumAssets = 0;
+		int32 NumAssetsWithURL = 0;
+		TMap<int32, int32> AssetsPerURL;
+
+		// Derived from AssetsPerURL, valid when CachedVersion matches the index
+		mutable uint32 CachedVersion = 0;
+		mutable int32 CachedNumAssetsWithLicense = 0;
+	};
+
+	FFolderEntry& FindOrAddFolder(FName FolderPath);
+
+	// Calls Visitor on the folder and each of its ancestors, up to and including the mount point root
+	template <typename FunctorType>
+	void ForEachFolderInChain(FName FolderPath, FunctorType&& Visitor)
+	{
+		for (FName Current = FolderPath; !Current.IsNone(); )
+		{
+			FFolderEntry& Entry = FindOrAddFolder(Current);
+			Visitor(Entry);
+			Current = Entry.Parent;
+		}
+	}
+
+private:
+	TMap<FName, FFolderEntry> Folders;
+
+	mutable FJamLicenseCacheCounter StatsCacheCounter;
+};
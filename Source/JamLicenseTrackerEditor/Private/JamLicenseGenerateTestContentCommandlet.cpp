@@ -0,0 +1,265 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseGenerateTestContentCommandlet.h"
+
+#include "JamAssetLicense.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "Algo/BinarySearch.h"
+#include "Engine/ObjectLibrary.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/MetaData.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+namespace JamLicenseGenerateTestContent
+{
+	// Samples ranks 0..N-1 with probability proportional to 1 / (rank + 1)^Exponent
+	class FZipfSampler
+	{
+	public:
+		FZipfSampler(int32 NumValues, double Exponent)
+		{
+			CumulativeWeights.Reserve(NumValues);
+			double Total = 0.0;
+			for (int32 Rank = 0; Rank < NumValues; ++Rank)
+			{
+				Total += 1.0 / FMath::Pow((double)(Rank + 1), Exponent);
+				CumulativeWeights.Add(Total);
+			}
+		}
+
+		int32 Sample(FRandomStream& Random) const
+		{
+			const double Target = Random.GetFraction() * CumulativeWeights.Last();
+			return FMath::Min(Algo::LowerBound(CumulativeWeights, Target), CumulativeWeights.Num() - 1);
+		}
+
+	private:
+		TArray<double> CumulativeWeights;
+	};
+
+	static bool SavePackageToDisk(UPackage* Package, UObject* MainAsset)
+	{
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+		SaveArgs.Error = GWarn;
+		return UPackage::SavePackage(Package, MainAsset, *Filename, SaveArgs);
+	}
+
+	// Once saved, the package only needs to stay in memory while something roots it, so let GC reclaim it otherwise.
+	// The saved libraries also drop their references, or every rooted asset would keep the chain of its predecessors alive
+	static void ReleaseSavedPackage(UPackage* Package)
+	{
+		ForEachObjectWithPackage(Package, [](UObject* Object)
+		{
+			if (UObjectLibrary* Library = Cast<UObjectLibrary>(Object))
+			{
+				Library->ClearLoaded();
+			}
+			Object->ClearFlags(RF_Standalone);
+			return true;
+		}, /*bIncludeNestedObjects=*/ false);
+	}
+
+	static FString MakeURL(int32 URLIndex)
+	{
+		return FString::Printf(TEXT("https://synthetic.example.com/vendor%d/pack%06d"), URLIndex % 97, URLIndex);
+	}
+}
+
+UJamLicenseGenerateTestContentCommandlet::UJamLicenseGenerateTestContentCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UJamLicenseGenerateTestContentCommandlet::Main(const FString& Params)
+{
+	using namespace JamLicenseGenerateTestContent;
+
+	int32 NumPackages = 10000;
+	int32 NumURLs = 1000;
+	double ZipfExponent = 1.1;
+	int32 MaxAssetsPerPackage = 4;
+	int32 MaxReferences = 4;
+	float UntaggedFraction = 0.1f;
+	float LicensedFraction = 0.8f;
+	int32 Seed = 1;
+	FString Root = TEXT("/Game/JamLicenseSynthetic");
+
+	FParse::Value(*Params, TEXT("Packages="), /*out*/ NumPackages);
+	FParse::Value(*Params, TEXT("URLs="), /*out*/ NumURLs);
+	FParse::Value(*Params, TEXT("Zipf="), /*out*/ ZipfExponent);
+	FParse::Value(*Params, TEXT("MaxAssetsPerPackage="), /*out*/ MaxAssetsPerPackage);
+	FParse::Value(*Params, TEXT("MaxReferences="), /*out*/ MaxReferences);
+	FParse::Value(*Params, TEXT("UntaggedFraction="), /*out*/ UntaggedFraction);
+	FParse::Value(*Params, TEXT("LicensedFraction="), /*out*/ LicensedFraction);
+	FParse::Value(*Params, TEXT("Seed="), /*out*/ Seed);
+	FParse::Value(*Params, TEXT("Root="), /*out*/ Root);
+
+	NumPackages = FMath::Max(NumPackages, 1);
+	NumURLs = FMath::Max(NumURLs, 1);
+	MaxAssetsPerPackage = FMath::Max(MaxAssetsPerPackage, 1);
+	MaxReferences = FMath::Max(MaxReferences, 0);
+
+	if (!FPackageName::IsValidLongPackageName(Root))
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("-Root=%s is not a valid content path"), *Root);
+		return 1;
+	}
+
+	FRandomStream Random(Seed);
+	const FZipfSampler URLSampler(NumURLs, ZipfExponent);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Popular assets that many others reference stay loaded for the whole run, everything else only while it's recent
+	const int32 NumHubAssets = FMath::Min(256, NumPackages / 10);
+	const int32 RecentWindowSize = 4096;
+	TArray<UObject*> HubAssets;
+	TArray<UObject*> RecentAssets;
+	int32 RecentCursor = 0;
+
+	int32 NumAssetsWritten = 0;
+	int32 NumFailures = 0;
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		// Spread packages over two levels of folders so folder rollups have something to do
+		const FString PackageName = FString::Printf(TEXT("%s/F%02d/F%03d/P%07d"), *Root, PackageIndex % 32, (PackageIndex / 32) % 256, PackageIndex);
+		UPackage* Package = CreatePackage(*PackageName);
+
+		const bool bTagged = Random.GetFraction() >= UntaggedFraction;
+		const FString URL = bTagged ? MakeURL(URLSampler.Sample(Random)) : FString();
+
+		const int32 NumAssets = Random.RandRange(1, MaxAssetsPerPackage);
+		UObject* MainAsset = nullptr;
+		for (int32 AssetIndex = 0; AssetIndex < NumAssets; ++AssetIndex)
+		{
+			const FName AssetName = (AssetIndex == 0) ? FName(*FPackageName::GetShortName(PackageName)) : FName(*FString::Printf(TEXT("%s_%d"), *FPackageName::GetShortName(PackageName), AssetIndex));
+			UObjectLibrary* Asset = NewObject<UObjectLibrary>(Package, AssetName, RF_Public | RF_Standalone);
+			MainAsset = (MainAsset != nullptr) ? MainAsset : Asset;
+
+			const int32 NumReferences = Random.RandRange(0, MaxReferences);
+			for (int32 ReferenceIndex = 0; ReferenceIndex < NumReferences; ++ReferenceIndex)
+			{
+				const bool bUseHub = (HubAssets.Num() > 0) && ((RecentAssets.Num() == 0) || (Random.GetFraction() < 0.3f));
+				const TArray<UObject*>& Candidates = bUseHub ? HubAssets : RecentAssets;
+				if (Candidates.Num() > 0)
+				{
+					Asset->AddObject(Candidates[Random.RandHelper(Candidates.Num())]);
+				}
+			}
+
+			if (bTagged)
+			{
+				Package->GetMetaData()->SetValue(Asset, MD_AssetSourceURL, *URL);
+			}
+		}
+
+		if (SavePackageToDisk(Package, MainAsset))
+		{
+			NumAssetsWritten += NumAssets;
+		}
+		else
+		{
+			++NumFailures;
+		}
+		ReleaseSavedPackage(Package);
+
+		// Keep the main asset referenceable by later packages
+		MainAsset->AddToRoot();
+		if (HubAssets.Num() < NumHubAssets)
+		{
+			HubAssets.Add(MainAsset);
+		}
+		else if (RecentAssets.Num() < RecentWindowSize)
+		{
+			RecentAssets.Add(MainAsset);
+		}
+		else
+		{
+			RecentAssets[RecentCursor]->RemoveFromRoot();
+			RecentAssets[RecentCursor] = MainAsset;
+			RecentCursor = (RecentCursor + 1) % RecentWindowSize;
+		}
+
+		if (((PackageIndex + 1) % 1000) == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			UE_LOG(LogJamLicenseTracker, Display, TEXT("Wrote %d / %d packages (%.1f s)"), PackageIndex + 1, NumPackages, FPlatformTime::Seconds() - StartTime);
+		}
+	}
+
+	// A license asset for some of the URLs, picked independently of popularity
+	int32 NumLicenses = 0;
+	for (int32 URLIndex = 0; URLIndex < NumURLs; ++URLIndex)
+	{
+		if (Random.GetFraction() >= LicensedFraction)
+		{
+			continue;
+		}
+
+		const FString PackageName = FString::Printf(TEXT("%s/Licenses/L%06d"), *Root, URLIndex);
+		UPackage* Package = CreatePackage(*PackageName);
+		UJamAssetLicense* License = NewObject<UJamAssetLicense>(Package, FName(*FPackageName::GetShortName(PackageName)), RF_Public | RF_Standalone);
+		License->AssetSourceURL = MakeURL(URLIndex);
+		License->SPDXIdentifier = (URLIndex % 3 == 0) ? TEXT("CC-BY-4.0") : ((URLIndex % 3 == 1) ? TEXT("CC0-1.0") : TEXT(""));
+		License->LicenseText = FString::Printf(TEXT("Synthetic license for %s"), *License->AssetSourceURL);
+
+		if (SavePackageToDisk(Package, License))
+		{
+			++NumLicenses;
+		}
+		else
+		{
+			++NumFailures;
+		}
+		ReleaseSavedPackage(Package);
+
+		if (((URLIndex + 1) % 1000) == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	for (UObject* Asset : HubAssets)
+	{
+		Asset->RemoveFromRoot();
+	}
+	for (UObject* Asset : RecentAssets)
+	{
+		Asset->RemoveFromRoot();
+	}
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("Generated %d assets and %d licenses under %s in %.1f s, %d packages failed to save"),
+		NumAssetsWritten, NumLicenses, *Root, FPlatformTime::Seconds() - StartTime, NumFailures);
+	return (NumFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "JamLicenseGenerateTestContentCommandlet.generated.h"
+
+// Generates a synthetic content tree for scale testing license tracking (registry scan, index build, menus, cook harvest)
+//
+// Usage: UnrealEditor-Cmd.exe MyProject.uproject -run=JamLicenseGenerateTestContent [options]
+//   -Packages=10000          Number of content packages to write
+//   -URLs=1000               Number of distinct asset source URLs
+//   -Zipf=1.1                Exponent of the Zipfian distribution of URLs over assets (0 is uniform)
+//   -MaxAssetsPerPackage=4   Each package holds between 1 and this many assets (all sharing the package's URL)
+//   -MaxReferences=4         Each asset hard references up to this many earlier assets
+//   -UntaggedFraction=0.1    Fraction of packages with no source URL
+//   -LicensedFraction=0.8    Fraction of URLs that get a UJamAssetLicense
+//   -Root=/Game/JamLicenseSynthetic
+//   -Seed=1
+//
+// Assets are UObjectLibrary instances (a small engine class that can hold hard references), with the source URL
+// stored in package metadata exactly as the Content Browser actions do. References go to a fixed set of popular
+// hub assets or to recently generated ones, so only a bounded window of objects is ever kept in memory
+UCLASS()
+class UJamLicenseGenerateTestContentCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJamLicenseGenerateTestContentCommandlet();
+
+	//~UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~End of UCommandlet interface
+};
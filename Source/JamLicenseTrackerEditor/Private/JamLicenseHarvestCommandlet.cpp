@@ -0,0 +1,80 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseHarvestCommandlet.h"
+
+#include "JamLicenseManifest.h"
+#include "JamLicenseManifestHarvester.h"
+#include "JamLicenseTagBackfill.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "IAssetRegistry.h"
+#include "Misc/Parse.h"
+
+UJamLicenseHarvestCommandlet::UJamLicenseHarvestCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UJamLicenseHarvestCommandlet::Main(const FString& Params)
+{
+	FString OutputFilename = FParse::Param(*Params, TEXT("Stage")) ? FJamLicenseManifest::GetStagedFilename() : FJamLicenseManifest::GetDefaultFilename();
+	FParse::Value(*Params, TEXT("Output="), /*out*/ OutputFilename);
+
+	IAssetRegistry::GetChecked().SearchAllAssets(/*bSynchronousSearch=*/ true);
+
+	// Picks up source URLs from packages saved before the tag was collected
+	if ((FJamLicenseTagBackfill::IsEnabled() || FParse::Param(*Params, TEXT("Backfill"))) && !FParse::Param(*Params, TEXT("NoBackfill")))
+	{
+		FJamLicenseTagBackfill::Run();
+	}
+
+	FJamLicenseManifest Manifest;
+	TArray<FJamLicenseManifestCultureSection> CultureSections;
+	const bool bHarvested = FJamLicenseManifestHarvester::Harvest(/*out*/ Manifest, /*out*/ CultureSections);
+
+	if (!Manifest.SaveToFile(OutputFilename))
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to write license manifest to %s"), *OutputFilename);
+		return 1;
+	}
+
+	for (const FJamLicenseManifestCultureSection& Section : CultureSections)
+	{
+		const FString SectionFilename = FJamLicenseManifestCultureSection::GetFilename(OutputFilename, Section.Culture);
+		if (!Section.SaveToFile(SectionFilename))
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to write license manifest culture section to %s"), *SectionFilename);
+			return 1;
+		}
+	}
+
+	int32 NumPackages = 0;
+	for (const FJamLicenseManifestEntry& Entry : Manifest.Licenses)
+	{
+		NumPackages += Entry.Packages.Num();
+	}
+
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("Wrote %d source URLs covering %d packages (with localized text for %d cultures) to %s"), Manifest.Licenses.Num(), NumPackages, CultureSections.Num(), *OutputFilename);
+	return bHarvested ? 0 : 1;
+}
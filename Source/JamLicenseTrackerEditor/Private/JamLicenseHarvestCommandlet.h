@@ -0,0 +1,44 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "JamLicenseHarvestCommandlet.generated.h"
+
+// Writes a license manifest (see FJamLicenseManifest) describing which packages are used under which license
+//
+// Usage: UnrealEditor-Cmd.exe MyProject.uproject -run=JamLicenseHarvest [-Stage] [-Output=Path/To/LicenseManifest.json] [-Backfill|-NoBackfill]
+//
+// -Stage writes to the location the runtime loads the manifest from (see FJamLicenseManifest::GetStagedFilename)
+// Missing source URL tags are backfilled first (see FJamLicenseTagBackfill) when that is on in the plugin settings or with -Backfill
+UCLASS()
+class UJamLicenseHarvestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJamLicenseHarvestCommandlet();
+
+	//~UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~End of UCommandlet interface
+};
@@ -0,0 +1,619 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseIndex.h"
+
+#include "AssetData.h"
+#include "IAssetRegistry.h"
+#include "Editor.h"
+#include "JamAssetLicense.h"
+#include "JamLicenseMemory.h"
+#include "Misc/PackageName.h"
+#include "UObject/MetaData.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+const TCHAR* MD_AssetSourceURL = TEXT("AssetSourceURL");
+
+namespace JamLicenseIndex
+{
+	// Game thread time a time-sliced build may use per tick
+	constexpr double BuildSliceSeconds = 0.004;
+
+	// Reading the clock for every asset would be a noticeable part of the slice
+	constexpr int32 AssetsPerClockCheck = 256;
+}
+
+struct FJamLicenseIndex::FTimeSlicedBuild
+{
+	enum class EEventType : uint8
+	{
+		Added,
+		Removed,
+		Renamed,
+		Updated
+	};
+
+	struct FQueuedEvent
+	{
+		EEventType Type;
+		FAssetData AssetData;
+		FString OldObjectPath;
+	};
+
+	TArray<FAssetData> Snapshot;
+	int32 NextSnapshotIndex = 0;
+
+	// Registry events broadcast after the snapshot was taken, in order
+	TArray<FQueuedEvent> QueuedEvents;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	double SecondsSpent = 0.0;
+};
+
+static TUniquePtr<FJamLicenseIndex> GJamLicenseIndex;
+
+void FJamLicenseIndex::Initialize(bool bTimeSliced)
+{
+	check(!GJamLicenseIndex.IsValid());
+	GJamLicenseIndex.Reset(new FJamLicenseIndex(bTimeSliced));
+}
+
+void FJamLicenseIndex::Shutdown()
+{
+	GJamLicenseIndex.Reset();
+}
+
+FJamLicenseIndex& FJamLicenseIndex::Get()
+{
+	check(GJamLicenseIndex.IsValid());
+	return *GJamLicenseIndex;
+}
+
+bool FJamLicenseIndex::IsAvailable()
+{
+	return GJamLicenseIndex.IsValid() && !GJamLicenseIndex->TimeSlicedBuild.IsValid();
+}
+
+bool FJamLicenseIndex::IsBuilding()
+{
+	return GJamLicenseIndex.IsValid() && GJamLicenseIndex->TimeSlicedBuild.IsValid();
+}
+
+FJamLicenseIndex::FJamLicenseIndex(bool bTimeSliced)
+	: Version(1)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	if (bTimeSliced)
+	{
+		// Copying the asset data is cheap (the tag maps are shared), reading the tags and filling the tables is what gets sliced up
+		TimeSlicedBuild = MakeUnique<FTimeSlicedBuild>();
+		AssetRegistry.GetAllAssets(/*out*/ TimeSlicedBuild->Snapshot);
+		TimeSlicedBuild->SecondsSpent = FPlatformTime::Seconds() - StartTime;
+		TimeSlicedBuild->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJamLicenseIndex::TickTimeSlicedBuild));
+	}
+	else
+	{
+		// Pick up whatever the registry already knows about, anything discovered later arrives via OnAssetAdded
+		AddAllFromAssetRegistry();
+
+		BuildSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FJamLicenseIndex::OnAssetAdded);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FJamLicenseIndex::OnAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FJamLicenseIndex::OnAssetRenamed);
+	AssetRegistry.OnAssetUpdated().AddRaw(this, &FJamLicenseIndex::OnAssetUpdated);
+
+	FEditorDelegates::PostUndoRedo.AddRaw(this, &FJamLicenseIndex::OnPostUndoRedo);
+	UPackage::PackageSavedWithContextEvent.AddRaw(this, &FJamLicenseIndex::OnPackageSaved);
+}
+
+FJamLicenseIndex::~FJamLicenseIndex()
+{
+	if (TimeSlicedBuild.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TimeSlicedBuild->TickerHandle);
+	}
+
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().RemoveAll(this);
+		AssetRegistry->OnAssetRemoved().RemoveAll(this);
+		AssetRegistry->OnAssetRenamed().RemoveAll(this);
+		AssetRegistry->OnAssetUpdated().RemoveAll(this);
+	}
+
+	FEditorDelegates::PostUndoRedo.RemoveAll(this);
+	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+}
+
+void FJamLicenseIndex::NotifyMetaDataChanged(TConstArrayView<UObject*> Assets, const FString& NewURL)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	const int32 URLId = NewURL.IsEmpty() ? INDEX_NONE : FindOrAddURLId(NewURL);
+
+	for (UObject* Asset : Assets)
+	{
+		PackagesWithUnsavedEdits.Add(Asset->GetOutermost()->GetFName());
+		SetAssetURLId(FName(*Asset->GetPathName()), URLId);
+	}
+
+	// Always bump, the summaries built from metadata may have seen an intermediate state
+	BumpVersion();
+}
+
+void FJamLicenseIndex::AddAllFromAssetRegistry()
+{
+	IAssetRegistry::GetChecked().EnumerateAllAssets([this](const FAssetData& AssetData)
+	{
+		CountAssetInFolder(AssetData, AssetData.PackagePath, 1);
+		AddFromAssetData(AssetData);
+		return true;
+	});
+}
+
+bool FJamLicenseIndex::ProcessBuildSnapshot(double TimeLimitSeconds)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TArray<FAssetData>& Snapshot = TimeSlicedBuild->Snapshot;
+	int32& NextIndex = TimeSlicedBuild->NextSnapshotIndex;
+
+	while (NextIndex < Snapshot.Num())
+	{
+		const FAssetData& AssetData = Snapshot[NextIndex++];
+		CountAssetInFolder(AssetData, AssetData.PackagePath, 1);
+		AddFromAssetData(AssetData);
+
+		if (((NextIndex % JamLicenseIndex::AssetsPerClockCheck) == 0) && ((FPlatformTime::Seconds() - StartTime) >= TimeLimitSeconds))
+		{
+			break;
+		}
+	}
+
+	TimeSlicedBuild->SecondsSpent += FPlatformTime::Seconds() - StartTime;
+	return NextIndex >= Snapshot.Num();
+}
+
+bool FJamLicenseIndex::TickTimeSlicedBuild(float DeltaTime)
+{
+	if (!ProcessBuildSnapshot(JamLicenseIndex::BuildSliceSeconds))
+	{
+		return true;
+	}
+
+	CompleteTimeSlicedBuild();
+	return false;
+}
+
+void FJamLicenseIndex::FinishBuild()
+{
+	if (TimeSlicedBuild.IsValid())
+	{
+		ProcessBuildSnapshot(TNumericLimits<double>::Max());
+		CompleteTimeSlicedBuild();
+	}
+}
+
+void FJamLicenseIndex::CompleteTimeSlicedBuild()
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	// Cleared first so the replayed events below update the tables instead of being queued again
+	TUniquePtr<FTimeSlicedBuild> Build = MoveTemp(TimeSlicedBuild);
+	FTSTicker::GetCoreTicker().RemoveTicker(Build->TickerHandle);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// The snapshot was taken on the game thread before any of these were broadcast, so replaying them in order catches the tables up
+	for (const FTimeSlicedBuild::FQueuedEvent& Event : Build->QueuedEvents)
+	{
+		switch (Event.Type)
+		{
+		case FTimeSlicedBuild::EEventType::Added:
+			OnAssetAdded(Event.AssetData);
+			break;
+		case FTimeSlicedBuild::EEventType::Removed:
+			OnAssetRemoved(Event.AssetData);
+			break;
+		case FTimeSlicedBuild::EEventType::Renamed:
+			OnAssetRenamed(Event.AssetData, Event.OldObjectPath);
+			break;
+		case FTimeSlicedBuild::EEventType::Updated:
+			OnAssetUpdated(Event.AssetData);
+			break;
+		}
+	}
+
+	// Metadata edits made during the build may be newer than the snapshot tags (this also bumps the version)
+	OnPostUndoRedo();
+
+	BuildSeconds = Build->SecondsSpent + (FPlatformTime::Seconds() - StartTime);
+	BuildFinishedEvent.Broadcast();
+}
+
+float FJamLicenseIndex::GetBuildProgress() const
+{
+	if (!TimeSlicedBuild.IsValid())
+	{
+		return 1.0f;
+	}
+
+	const int32 NumAssets = TimeSlicedBuild->Snapshot.Num();
+	return (NumAssets > 0) ? ((float)TimeSlicedBuild->NextSnapshotIndex / (float)NumAssets) : 0.0f;
+}
+
+void FJamLicenseIndex::Rebuild()
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	FinishBuild();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// URL ids are kept (other tables refer to them), only what uses them is recounted
+	for (FURLEntry& Entry : URLEntries)
+	{
+		Entry.NumAssets = 0;
+		Entry.NumLicenseAssets = 0;
+	}
+	AssetToURLId.Reset();
+	LicenseAssets.Reset();
+	FolderCoverage.Reset();
+
+	AddAllFromAssetRegistry();
+
+	// Re-apply metadata edits the registry tags don't reflect yet (this also bumps the version)
+	OnPostUndoRedo();
+
+	BuildSeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+void FJamLicenseIndex::BumpVersion()
+{
+	Version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+int32 FJamLicenseIndex::FindOrAddURLId(const FString& URL)
+{
+	if (const int32* pExistingId = URLToId.Find(URL))
+	{
+		return *pExistingId;
+	}
+
+	const int32 NewId = URLEntries.AddDefaulted();
+	URLEntries[NewId].URL = URL;
+	URLToId.Add(URL, NewId);
+	return NewId;
+}
+
+// Returns the folder containing the package of an object path (e.g., /Game/Props for /Game/Props/SM_Crate.SM_Crate)
+static FName GetPackagePathFromObjectPath(FName ObjectPath)
+{
+	const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath.ToString());
+	return FName(*FPackageName::GetLongPackagePath(PackageName));
+}
+
+bool FJamLicenseIndex::SetAssetURLId(FName ObjectPath, int32 URLId)
+{
+	const int32 OldURLId = GetAssetURLId(ObjectPath);
+	if (OldURLId == URLId)
+	{
+		return false;
+	}
+
+	FolderCoverage.ChangeAssetURL(GetPackagePathFromObjectPath(ObjectPath), OldURLId, URLId);
+
+	if (OldURLId != INDEX_NONE)
+	{
+		--URLEntries[OldURLId].NumAssets;
+	}
+
+	if (URLId != INDEX_NONE)
+	{
+		++URLEntries[URLId].NumAssets;
+		AssetToURLId.Add(ObjectPath, URLId);
+	}
+	else
+	{
+		AssetToURLId.Remove(ObjectPath);
+	}
+
+	return true;
+}
+
+bool FJamLicenseIndex::SetLicenseAsset(FName ObjectPath, int32 URLId, const FString& SPDXIdentifier)
+{
+	FLicenseAssetEntry* ExistingEntry = LicenseAssets.Find(ObjectPath);
+	const int32 OldURLId = (ExistingEntry != nullptr) ? ExistingEntry->URLId : INDEX_NONE;
+	if ((OldURLId == URLId) && ((ExistingEntry == nullptr) || ExistingEntry->SPDXIdentifier.Equals(SPDXIdentifier, ESearchCase::CaseSensitive)))
+	{
+		return false;
+	}
+
+	if (OldURLId != INDEX_NONE)
+	{
+		--URLEntries[OldURLId].NumLicenseAssets;
+	}
+
+	if (URLId != INDEX_NONE)
+	{
+		++URLEntries[URLId].NumLicenseAssets;
+		LicenseAssets.Add(ObjectPath, FLicenseAssetEntry{ URLId, SPDXIdentifier });
+	}
+	else
+	{
+		LicenseAssets.Remove(ObjectPath);
+	}
+
+	return true;
+}
+
+bool FJamLicenseIndex::AddFromAssetData(const FAssetData& AssetData)
+{
+	FString URL;
+	const bool bHasURL = AssetData.GetTagValue(FName(MD_AssetSourceURL), /*out*/ URL) && !URL.IsEmpty();
+	const int32 URLId = bHasURL ? FindOrAddURLId(URL) : INDEX_NONE;
+
+	bool bChanged = SetAssetURLId(AssetData.ObjectPath, URLId);
+	if (AssetData.AssetClass == UJamAssetLicense::StaticClass()->GetFName())
+	{
+		const FString SPDXIdentifier = AssetData.GetTagValueRef<FString>(GET_MEMBER_NAME_CHECKED(UJamAssetLicense, SPDXIdentifier));
+		bChanged |= SetLicenseAsset(AssetData.ObjectPath, URLId, SPDXIdentifier);
+	}
+
+	return bChanged;
+}
+
+void FJamLicenseIndex::CountAssetInFolder(const FAssetData& AssetData, FName PackagePath, int32 Delta)
+{
+	if (AssetData.AssetClass != UObjectRedirector::StaticClass()->GetFName())
+	{
+		FolderCoverage.AddAsset(PackagePath, INDEX_NONE, Delta);
+	}
+}
+
+bool FJamLicenseIndex::RemoveAsset(FName ObjectPath)
+{
+	bool bChanged = SetAssetURLId(ObjectPath, INDEX_NONE);
+	bChanged |= SetLicenseAsset(ObjectPath, INDEX_NONE, FString());
+	return bChanged;
+}
+
+// Sorts ids by a string key and assigns each a dense rank (ids with equal keys share a rank, empty keys sort last)
+static void BuildRanks(int32 NumIds, TFunctionRef<const FString&(int32)> GetKey, TArray<int32>& OutRanks)
+{
+	TArray<int32> SortedIds;
+	SortedIds.Reserve(NumIds);
+	for (int32 Id = 0; Id < NumIds; ++Id)
+	{
+		SortedIds.Add(Id);
+	}
+
+	SortedIds.Sort([&GetKey](int32 A, int32 B)
+	{
+		const FString& KeyA = GetKey(A);
+		const FString& KeyB = GetKey(B);
+		if (KeyA.IsEmpty() != KeyB.IsEmpty())
+		{
+			return KeyB.IsEmpty();
+		}
+		return KeyA.Compare(KeyB, ESearchCase::IgnoreCase) < 0;
+	});
+
+	OutRanks.SetNumUninitialized(NumIds);
+	int32 Rank = 0;
+	for (int32 SortedIndex = 0; SortedIndex < SortedIds.Num(); ++SortedIndex)
+	{
+		if ((SortedIndex > 0) && !GetKey(SortedIds[SortedIndex]).Equals(GetKey(SortedIds[SortedIndex - 1]), ESearchCase::IgnoreCase))
+		{
+			++Rank;
+		}
+		OutRanks[SortedIds[SortedIndex]] = Rank;
+	}
+}
+
+const FJamLicenseURLSortData& FJamLicenseIndex::GetURLSortData()
+{
+	const uint32 CurrentVersion = GetVersion();
+	URLSortDataCounter.Record(URLSortData.Version == CurrentVersion);
+	if (URLSortData.Version == CurrentVersion)
+	{
+		return URLSortData;
+	}
+
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	const int32 NumIds = URLEntries.Num();
+	URLSortData.Version = CurrentVersion;
+
+	// Pick a license asset for each URL
+	URLSortData.LicenseAsset.Reset();
+	URLSortData.LicenseAsset.SetNum(NumIds);
+	URLSortData.SPDXIdentifier.Reset();
+	URLSortData.SPDXIdentifier.SetNum(NumIds);
+	for (const TPair<FName, FLicenseAssetEntry>& Pair : LicenseAssets)
+	{
+		FName& ChosenLicense = URLSortData.LicenseAsset[Pair.Value.URLId];
+		if (ChosenLicense.IsNone() || Pair.Key.LexicalLess(ChosenLicense))
+		{
+			ChosenLicense = Pair.Key;
+			URLSortData.SPDXIdentifier[Pair.Value.URLId] = Pair.Value.SPDXIdentifier;
+		}
+	}
+
+	TArray<FString> LicenseAssetNames;
+	LicenseAssetNames.Reserve(NumIds);
+	for (FName LicenseAsset : URLSortData.LicenseAsset)
+	{
+		LicenseAssetNames.Add(LicenseAsset.IsNone() ? FString() : LicenseAsset.ToString());
+	}
+
+	BuildRanks(NumIds, [this](int32 Id) -> const FString& { return URLEntries[Id].URL; }, URLSortData.URLRank);
+	BuildRanks(NumIds, [&LicenseAssetNames](int32 Id) -> const FString& { return LicenseAssetNames[Id]; }, URLSortData.LicenseAssetRank);
+	BuildRanks(NumIds, [this](int32 Id) -> const FString& { return URLSortData.SPDXIdentifier[Id]; }, URLSortData.SPDXRank);
+
+	return URLSortData;
+}
+
+void FJamLicenseIndex::GetMemoryUsage(FJamLicenseMemoryUsage& InOutUsage) const
+{
+	InOutUsage.IndexTables += URLEntries.GetAllocatedSize() + URLToId.GetAllocatedSize() + AssetToURLId.GetAllocatedSize() + LicenseAssets.GetAllocatedSize();
+	InOutUsage.IndexTables += FolderCoverage.GetAllocatedSize() + PackagesWithUnsavedEdits.GetAllocatedSize();
+
+	for (const FURLEntry& Entry : URLEntries)
+	{
+		InOutUsage.StringPools += Entry.URL.GetAllocatedSize();
+	}
+	for (const TPair<FString, int32>& Pair : URLToId)
+	{
+		InOutUsage.StringPools += Pair.Key.GetAllocatedSize();
+	}
+	for (const TPair<FName, FLicenseAssetEntry>& Pair : LicenseAssets)
+	{
+		InOutUsage.StringPools += Pair.Value.SPDXIdentifier.GetAllocatedSize();
+	}
+
+	InOutUsage.Caches += URLSortData.URLRank.GetAllocatedSize() + URLSortData.LicenseAsset.GetAllocatedSize() + URLSortData.LicenseAssetRank.GetAllocatedSize();
+	InOutUsage.Caches += URLSortData.SPDXIdentifier.GetAllocatedSize() + URLSortData.SPDXRank.GetAllocatedSize();
+	for (const FString& SPDXIdentifier : URLSortData.SPDXIdentifier)
+	{
+		InOutUsage.Caches += SPDXIdentifier.GetAllocatedSize();
+	}
+}
+
+void FJamLicenseIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	if (TimeSlicedBuild.IsValid())
+	{
+		TimeSlicedBuild->QueuedEvents.Add({ FTimeSlicedBuild::EEventType::Added, AssetData, FString() });
+		return;
+	}
+
+	// Folder totals invalidate their own cached values, so only license changes need a version bump
+	if (!bReaddingExistingAssets)
+	{
+		CountAssetInFolder(AssetData, AssetData.PackagePath, 1);
+	}
+	if (AddFromAssetData(AssetData))
+	{
+		BumpVersion();
+	}
+}
+
+void FJamLicenseIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	if (TimeSlicedBuild.IsValid())
+	{
+		TimeSlicedBuild->QueuedEvents.Add({ FTimeSlicedBuild::EEventType::Removed, AssetData, FString() });
+		return;
+	}
+
+	CountAssetInFolder(AssetData, AssetData.PackagePath, -1);
+	if (RemoveAsset(AssetData.ObjectPath))
+	{
+		BumpVersion();
+	}
+}
+
+void FJamLicenseIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	if (TimeSlicedBuild.IsValid())
+	{
+		TimeSlicedBuild->QueuedEvents.Add({ FTimeSlicedBuild::EEventType::Renamed, AssetData, OldObjectPath });
+		return;
+	}
+
+	const FName OldObjectPathName(*OldObjectPath);
+	CountAssetInFolder(AssetData, GetPackagePathFromObjectPath(OldObjectPathName), -1);
+	CountAssetInFolder(AssetData, AssetData.PackagePath, 1);
+
+	bool bChanged = RemoveAsset(OldObjectPathName);
+	bChanged |= AddFromAssetData(AssetData);
+	if (bChanged)
+	{
+		BumpVersion();
+	}
+}
+
+void FJamLicenseIndex::OnAssetUpdated(const FAssetData& AssetData)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	if (TimeSlicedBuild.IsValid())
+	{
+		TimeSlicedBuild->QueuedEvents.Add({ FTimeSlicedBuild::EEventType::Updated, AssetData, FString() });
+		return;
+	}
+
+	if (AddFromAssetData(AssetData))
+	{
+		BumpVersion();
+	}
+}
+
+void FJamLicenseIndex::OnPostUndoRedo()
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	// Undo/redo can change package metadata without going through NotifyMetaDataChanged, so re-read anything we've touched
+	for (const FName PackageName : PackagesWithUnsavedEdits)
+	{
+		if (UPackage* Package = FindObjectFast<UPackage>(nullptr, PackageName))
+		{
+			UMetaData* Metadata = Package->HasMetaData() ? Package->GetMetaData() : nullptr;
+
+			ForEachObjectWithPackage(Package, [this, Metadata](UObject* Obj)
+			{
+				if (Obj->IsAsset())
+				{
+					const FString URL = (Metadata != nullptr) ? Metadata->GetValue(Obj, MD_AssetSourceURL) : FString();
+					SetAssetURLId(FName(*Obj->GetPathName()), URL.IsEmpty() ? INDEX_NONE : FindOrAddURLId(URL));
+				}
+				return true;
+			}, /*bIncludeNestedObjects=*/ false);
+		}
+	}
+
+	BumpVersion();
+}
+
+void FJamLicenseIndex::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	// The asset registry tags are refreshed from the saved package, so they are trustworthy again
+	if (!ObjectSaveContext.IsProceduralSave())
+	{
+		PackagesWithUnsavedEdits.Remove(Package->GetFName());
+	}
+}
@@ -0,0 +1,305 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectSaveContext.h"
+#include "JamLicenseFolderCoverage.h"
+
+#include <atomic>
+
+struct FAssetData;
+struct FJamLicenseMemoryUsage;
+
+// The package metadata key that stores the asset source URL (it is also copied into the asset registry as a tag of the same name)
+extern const TCHAR* MD_AssetSourceURL;
+
+// License state of a single asset
+enum class EJamLicenseState : uint8
+{
+	// The asset has no source URL
+	NoSource,
+
+	// The asset has a source URL, but there is no UJamAssetLicense for that URL
+	SourceWithoutLicense,
+
+	// The asset has a source URL and a UJamAssetLicense for it exists
+	Licensed
+};
+
+// Per-URL data used to display and sort assets by their source URL or license, indexed by URL id
+//
+// Ranks are dense (equal keys share a rank), so sorting a list of assets by any column only compares integers
+struct FJamLicenseURLSortData
+{
+	// Index version these were built for
+	uint32 Version = 0;
+
+	TArray<int32> URLRank;
+
+	// Object path of the license asset covering each URL (the first by name if there are several)
+	TArray<FName> LicenseAsset;
+	TArray<int32> LicenseAssetRank;
+
+	TArray<FString> SPDXIdentifier;
+	TArray<int32> SPDXRank;
+};
+
+// Editor-side view of which assets are associated with which asset source URLs
+//
+// Built from the asset registry tags and kept up to date incrementally from asset registry events
+// (plus edits made through the plugin that haven't been saved yet), so lookups never touch UMetaData.
+// URLs are interned into small integer ids that are stable for the lifetime of the index.
+//
+// Anything derived from license state (e.g., cached menu summaries) should be keyed on GetVersion(),
+// which is bumped whenever an asset registry change or metadata edit could have changed an answer
+//
+// A time-sliced index takes a snapshot of the registry when it is created and works through it a few milliseconds per
+// tick; registry events that arrive in the meantime are queued and replayed once the snapshot has been processed
+class FJamLicenseIndex
+{
+public:
+	explicit FJamLicenseIndex(bool bTimeSliced = false);
+	~FJamLicenseIndex();
+
+	static void Initialize(bool bTimeSliced = false);
+	static void Shutdown();
+	static FJamLicenseIndex& Get();
+
+	// The index is only created for interactive editor sessions, so code that can also run in commandlets should check this first
+	// (this is also false while a time-sliced build is still running)
+	static bool IsAvailable();
+
+	// Returns true if the index has been created but its time-sliced build hasn't finished yet
+	static bool IsBuilding();
+
+	// Processes the rest of a time-sliced build right away (game thread only)
+	void FinishBuild();
+
+	// Returns how much of a time-sliced build has been done (0..1)
+	float GetBuildProgress() const;
+
+	// Broadcast on the game thread when a time-sliced build finishes
+	FSimpleMulticastDelegate& OnBuildFinished()
+	{
+		return BuildFinishedEvent;
+	}
+
+	// Returns the current version of the license state (safe to call from any thread)
+	uint32 GetVersion() const
+	{
+		return Version.load(std::memory_order_acquire);
+	}
+
+	// Should be called after directly modifying the asset source URL metadata of assets
+	void NotifyMetaDataChanged(TConstArrayView<UObject*> Assets, const FString& NewURL);
+
+	// Returns true if the package has asset source URL edits that haven't been saved yet, which means
+	// the asset registry tags for it may be stale (game thread only)
+	bool HasUnsavedMetaDataEdits(FName PackageName) const
+	{
+		return PackagesWithUnsavedEdits.Contains(PackageName);
+	}
+
+	bool HasAnyUnsavedMetaDataEdits() const
+	{
+		return PackagesWithUnsavedEdits.Num() > 0;
+	}
+
+	// The rest of the API is game thread only
+
+	// Returns the id of the URL, or INDEX_NONE if no asset or license has ever used it
+	int32 FindURLId(const FString& URL) const
+	{
+		const int32* pId = URLToId.Find(URL);
+		return (pId != nullptr) ? *pId : INDEX_NONE;
+	}
+
+	const FString& GetURL(int32 URLId) const
+	{
+		return URLEntries[URLId].URL;
+	}
+
+	// Returns the number of URL ids that have been handed out (some may no longer be in use)
+	int32 GetNumURLIds() const
+	{
+		return URLEntries.Num();
+	}
+
+	// Returns the number of assets currently using the URL
+	int32 GetNumAssetsUsingURL(int32 URLId) const
+	{
+		return URLEntries[URLId].NumAssets;
+	}
+
+	// Returns true if at least one UJamAssetLicense exists for the URL
+	bool HasLicenseAsset(int32 URLId) const
+	{
+		return URLEntries[URLId].NumLicenseAssets > 0;
+	}
+
+	// Returns the URL id of the asset, or INDEX_NONE if it has no source URL
+	int32 GetAssetURLId(FName ObjectPath) const
+	{
+		const int32* pId = AssetToURLId.Find(ObjectPath);
+		return (pId != nullptr) ? *pId : INDEX_NONE;
+	}
+
+	EJamLicenseState GetAssetState(FName ObjectPath) const
+	{
+		const int32 URLId = GetAssetURLId(ObjectPath);
+		if (URLId == INDEX_NONE)
+		{
+			return EJamLicenseState::NoSource;
+		}
+		return HasLicenseAsset(URLId) ? EJamLicenseState::Licensed : EJamLicenseState::SourceWithoutLicense;
+	}
+
+	// Returns every asset that has a source URL, mapped to the URL id
+	const TMap<FName, int32>& GetAssetURLIds() const
+	{
+		return AssetToURLId;
+	}
+
+	// Returns the coverage totals for a content folder and everything below it
+	FJamLicenseFolderStats GetFolderStats(FName FolderPath) const
+	{
+		return FolderCoverage.GetStats(FolderPath, GetVersion(), [this](int32 URLId) { return HasLicenseAsset(URLId); });
+	}
+
+	void GetChildFolders(FName FolderPath, TArray<FName>& OutChildren) const
+	{
+		FolderCoverage.GetChildFolders(FolderPath, OutChildren);
+	}
+
+	void GetRootFolders(TArray<FName>& OutRoots) const
+	{
+		FolderCoverage.GetRootFolders(OutRoots);
+	}
+
+	// Returns the sort ranks and license columns for all URL ids, rebuilding them if the index has changed since last time
+	const FJamLicenseURLSortData& GetURLSortData();
+
+	void GetMemoryUsage(FJamLicenseMemoryUsage& InOutUsage) const;
+
+	// Throws away the tables and rebuilds them from the asset registry (URL ids stay the same)
+	void Rebuild();
+
+	// How long the last full build of the tables took (for time-sliced builds, only the time spent in the slices)
+	double GetBuildSeconds() const
+	{
+		return BuildSeconds;
+	}
+
+	int32 GetNumLicenseAssets() const
+	{
+		return LicenseAssets.Num();
+	}
+
+	const FJamLicenseFolderCoverage& GetFolderCoverage() const
+	{
+		return FolderCoverage;
+	}
+
+	// While set, asset added events are treated as tag updates of assets the index already has (see FJamLicenseTagBackfill::Inject)
+	void SetReaddingExistingAssets(bool bReadding)
+	{
+		bReaddingExistingAssets = bReadding;
+	}
+
+	// Hits are GetURLSortData calls that didn't need to rebuild
+	const FJamLicenseCacheCounter& GetURLSortDataCounter() const
+	{
+		return URLSortDataCounter;
+	}
+
+private:
+	struct FURLEntry
+	{
+		FString URL;
+		int32 NumAssets = 0;
+		int32 NumLicenseAssets = 0;
+	};
+
+	void BumpVersion();
+
+	int32 FindOrAddURLId(const FString& URL);
+
+	// Sets or clears (URLId == INDEX_NONE) the URL used by an asset, returning true if anything changed
+	bool SetAssetURLId(FName ObjectPath, int32 URLId);
+	bool SetLicenseAsset(FName ObjectPath, int32 URLId, const FString& SPDXIdentifier);
+
+	// Updates the tables from the asset registry view of an asset, returning true if anything changed
+	bool AddFromAssetData(const FAssetData& AssetData);
+	bool RemoveAsset(FName ObjectPath);
+
+	// Adds or removes an asset from the folder totals (tag changes are tracked separately by SetAssetURLId)
+	void CountAssetInFolder(const FAssetData& AssetData, FName PackagePath, int32 Delta);
+
+	// Adds every asset the registry knows about
+	void AddAllFromAssetRegistry();
+
+	// Adds snapshot entries until the time limit has passed, returning true once the whole snapshot has been processed
+	bool ProcessBuildSnapshot(double TimeLimitSeconds);
+	bool TickTimeSlicedBuild(float DeltaTime);
+	void CompleteTimeSlicedBuild();
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AssetData);
+	void OnPostUndoRedo();
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+
+private:
+	std::atomic<uint32> Version;
+
+	TArray<FURLEntry> URLEntries;
+	TMap<FString, int32> URLToId;
+
+	// Every asset with a source URL (including license assets, which carry the URL they cover)
+	TMap<FName, int32> AssetToURLId;
+
+	struct FLicenseAssetEntry
+	{
+		int32 URLId = INDEX_NONE;
+		FString SPDXIdentifier;
+	};
+
+	// Every UJamAssetLicense that covers a URL
+	TMap<FName, FLicenseAssetEntry> LicenseAssets;
+
+	FJamLicenseURLSortData URLSortData;
+	FJamLicenseCacheCounter URLSortDataCounter;
+
+	FJamLicenseFolderCoverage FolderCoverage;
+
+	TSet<FName> PackagesWithUnsavedEdits;
+
+	// Only set while a time-sliced build is running
+	struct FTimeSlicedBuild;
+	TUniquePtr<FTimeSlicedBuild> TimeSlicedBuild;
+	FSimpleMulticastDelegate BuildFinishedEvent;
+
+	double BuildSeconds = 0.0;
+	bool bReaddingExistingAssets = false;
+};
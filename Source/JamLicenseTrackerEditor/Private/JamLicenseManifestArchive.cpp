@@ -0,0 +1,641 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseManifestArchive.h"
+
+#include "JamLicenseManifest.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace JamLicenseManifestArchive
+{
+	// Version 1 roots held the whole URL -> entry hash table, version 2 roots reference it in chunks
+	static constexpr int32 FormatVersion = 2;
+
+	// A chunk ends after a name whose hash has these bits clear, for an average of 64 names per chunk
+	static constexpr uint64 ChunkBoundaryMask = 63;
+
+	static bool IsChunkBoundary(const FString& Name)
+	{
+		return (CityHash64((const char*)*Name, Name.Len() * sizeof(TCHAR)) & ChunkBoundaryMask) == 0;
+	}
+
+	// Returns the entry table chunks referenced by a root (none for version 1 roots)
+	static TArray<FString> GetEntryChunkHashes(const TSharedPtr<FJsonObject>& Root)
+	{
+		TArray<FString> ChunkHashes;
+		if (Root.IsValid())
+		{
+			Root->TryGetStringArrayField(TEXT("entryChunks"), /*out*/ ChunkHashes);
+		}
+		return ChunkHashes;
+	}
+
+	static FString ToJson(const TSharedRef<FJsonObject>& Object)
+	{
+		FString Text;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+		FJsonSerializer::Serialize(Object, Writer);
+		return Text;
+	}
+
+	static TSharedPtr<FJsonObject> FromJson(const FString& Text)
+	{
+		TSharedPtr<FJsonObject> Object;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		FJsonSerializer::Deserialize(Reader, /*out*/ Object);
+		return Object;
+	}
+
+	static TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FString>& Strings)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(Strings.Num());
+		for (const FString& String : Strings)
+		{
+			Values.Add(MakeShared<FJsonValueString>(String));
+		}
+		return Values;
+	}
+
+	// Returns the URL -> hash pairs stored in a root or culture object
+	static TMap<FString, FString> ReadHashMap(const TSharedPtr<FJsonObject>& Object, const TCHAR* FieldName)
+	{
+		TMap<FString, FString> Result;
+		const TSharedPtr<FJsonObject>* MapObject = nullptr;
+		if (Object.IsValid() && Object->TryGetObjectField(FieldName, /*out*/ MapObject))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*MapObject)->Values)
+			{
+				Result.Add(Pair.Key, Pair.Value->AsString());
+			}
+		}
+		return Result;
+	}
+}
+
+FJamLicenseManifestArchive::FJamLicenseManifestArchive(const FString& InArchiveDir)
+	: ArchiveDir(InArchiveDir)
+{
+}
+
+FString FJamLicenseManifestArchive::GetDefaultDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("JamLicenseTracker") / TEXT("Archive");
+}
+
+FString FJamLicenseManifestArchive::GetObjectFilename(const FString& Hash) const
+{
+	return ArchiveDir / TEXT("objects") / Hash.Left(2) / Hash.RightChop(2);
+}
+
+FString FJamLicenseManifestArchive::GetBuildsFilename() const
+{
+	return ArchiveDir / TEXT("builds.json");
+}
+
+FString FJamLicenseManifestArchive::PutObject(const FString& Contents)
+{
+	FTCHARToUTF8 Converted(*Contents);
+
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Converted.Get(), Converted.Length(), Hash.Hash);
+	const FString HashString = Hash.ToString().ToLower();
+
+	// Objects are immutable, so an existing file with this name already has the right contents
+	const FString Filename = GetObjectFilename(HashString);
+	if (!IFileManager::Get().FileExists(*Filename))
+	{
+		const FString TempFilename = Filename + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(TArrayView<const uint8>((const uint8*)Converted.Get(), Converted.Length()), *TempFilename) ||
+			!IFileManager::Get().Move(*Filename, *TempFilename))
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to write archive object %s"), *Filename);
+			return FString();
+		}
+	}
+
+	return HashString;
+}
+
+bool FJamLicenseManifestArchive::GetObject(const FString& Hash, FString& OutContents) const
+{
+	return !Hash.IsEmpty() && FFileHelper::LoadFileToString(/*out*/ OutContents, *GetObjectFilename(Hash));
+}
+
+FString FJamLicenseManifestArchive::PutPackages(const TArray<FName>& Packages)
+{
+	using namespace JamLicenseManifestArchive;
+
+	// Chunk boundaries depend only on the names themselves, so an edit only disturbs the chunk it lands in
+	TArray<FString> ChunkHashes;
+	FString Chunk;
+	for (int32 Index = 0; Index < Packages.Num(); ++Index)
+	{
+		const FString Name = Packages[Index].ToString();
+		Chunk += Name;
+		Chunk += TEXT("\n");
+
+		if (IsChunkBoundary(Name) || (Index == Packages.Num() - 1))
+		{
+			const FString ChunkHash = PutObject(Chunk);
+			if (ChunkHash.IsEmpty())
+			{
+				return FString();
+			}
+			ChunkHashes.Add(ChunkHash);
+			Chunk.Reset();
+		}
+	}
+
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetArrayField(TEXT("chunks"), ToJsonArray(ChunkHashes));
+	return PutObject(ToJson(Object));
+}
+
+bool FJamLicenseManifestArchive::PutEntryTable(const TArray<TPair<FString, FString>>& EntryHashes, TArray<FString>& OutChunkHashes)
+{
+	using namespace JamLicenseManifestArchive;
+
+	// Chunked by URL the same way package lists are, so a build only writes the chunks holding entries that changed
+	FString Chunk;
+	for (int32 Index = 0; Index < EntryHashes.Num(); ++Index)
+	{
+		Chunk += EntryHashes[Index].Value;
+		Chunk += TEXT(" ");
+		Chunk += EntryHashes[Index].Key;
+		Chunk += TEXT("\n");
+
+		if (IsChunkBoundary(EntryHashes[Index].Key) || (Index == EntryHashes.Num() - 1))
+		{
+			const FString ChunkHash = PutObject(Chunk);
+			if (ChunkHash.IsEmpty())
+			{
+				return false;
+			}
+			OutChunkHashes.Add(ChunkHash);
+			Chunk.Reset();
+		}
+	}
+	return true;
+}
+
+bool FJamLicenseManifestArchive::GetEntryTable(const TSharedPtr<FJsonObject>& Root, const TSet<FString>& ChunksToSkip, TMap<FString, FString>& OutEntryHashes) const
+{
+	using namespace JamLicenseManifestArchive;
+
+	if (!Root.IsValid())
+	{
+		return false;
+	}
+
+	if (!Root->HasField(TEXT("entryChunks")))
+	{
+		OutEntryHashes.Append(ReadHashMap(Root, TEXT("entries")));
+		return true;
+	}
+
+	for (const FString& ChunkHash : GetEntryChunkHashes(Root))
+	{
+		if (ChunksToSkip.Contains(ChunkHash))
+		{
+			continue;
+		}
+
+		FString Chunk;
+		if (!GetObject(ChunkHash, /*out*/ Chunk))
+		{
+			return false;
+		}
+
+		TArray<FString> Lines;
+		Chunk.ParseIntoArrayLines(/*out*/ Lines);
+		for (const FString& Line : Lines)
+		{
+			FString EntryHash;
+			FString URL;
+			if (!Line.Split(TEXT(" "), /*out*/ &EntryHash, /*out*/ &URL))
+			{
+				return false;
+			}
+			OutEntryHashes.Add(URL, EntryHash);
+		}
+	}
+	return true;
+}
+
+bool FJamLicenseManifestArchive::GetPackages(const FString& Hash, TArray<FName>& OutPackages) const
+{
+	using namespace JamLicenseManifestArchive;
+
+	FString Contents;
+	TSharedPtr<FJsonObject> Object = GetObject(Hash, /*out*/ Contents) ? FromJson(Contents) : nullptr;
+	if (!Object.IsValid())
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& ChunkValue : Object->GetArrayField(TEXT("chunks")))
+	{
+		FString Chunk;
+		if (!GetObject(ChunkValue->AsString(), /*out*/ Chunk))
+		{
+			return false;
+		}
+
+		TArray<FString> Names;
+		Chunk.ParseIntoArrayLines(/*out*/ Names);
+		for (const FString& Name : Names)
+		{
+			OutPackages.Add(FName(*Name));
+		}
+	}
+	return true;
+}
+
+FString FJamLicenseManifestArchive::StoreBuild(const FString& BuildId, const FJamLicenseManifest& Manifest, const TArray<FJamLicenseManifestCultureSection>& CultureSections)
+{
+	using namespace JamLicenseManifestArchive;
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	FString ExistingRootHash;
+	FString IgnoredError;
+	const bool bAlreadyStored = FindRootHash(BuildId, /*out*/ ExistingRootHash, /*out*/ IgnoredError);
+
+	// Any object that failed to write would leave the build referencing something that isn't there
+	bool bAllObjectsWritten = true;
+	auto Written = [&bAllObjectsWritten](const FString& Hash)
+	{
+		bAllObjectsWritten &= !Hash.IsEmpty();
+		return Hash;
+	};
+
+	TArray<TPair<FString, FString>> EntryHashes;
+	EntryHashes.Reserve(Manifest.Licenses.Num());
+	for (const FJamLicenseManifestEntry& Entry : Manifest.Licenses)
+	{
+		TArray<FString> Platforms;
+		for (FName Platform : Entry.AllowedPlatforms)
+		{
+			Platforms.Add(Platform.ToString());
+		}
+
+		TSharedRef<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+		EntryObject->SetStringField(TEXT("url"), Entry.AssetSourceURL);
+		EntryObject->SetStringField(TEXT("licenseAsset"), Entry.LicenseAsset);
+		EntryObject->SetStringField(TEXT("spdx"), Entry.SPDXIdentifier);
+		EntryObject->SetArrayField(TEXT("platforms"), ToJsonArray(Platforms));
+		EntryObject->SetStringField(TEXT("text"), Written(PutObject(Entry.LicenseText)));
+		EntryObject->SetStringField(TEXT("packages"), Written(PutPackages(Entry.Packages)));
+		EntryHashes.Emplace(Entry.AssetSourceURL, Written(PutObject(ToJson(EntryObject))));
+	}
+
+	TSharedRef<FJsonObject> Cultures = MakeShared<FJsonObject>();
+	for (const FJamLicenseManifestCultureSection& Section : CultureSections)
+	{
+		TArray<FString> URLs;
+		Section.LicenseTextByURL.GenerateKeyArray(/*out*/ URLs);
+		URLs.Sort();
+
+		TSharedRef<FJsonObject> Texts = MakeShared<FJsonObject>();
+		for (const FString& URL : URLs)
+		{
+			Texts->SetStringField(URL, Written(PutObject(Section.LicenseTextByURL[URL])));
+		}
+
+		TSharedRef<FJsonObject> SectionObject = MakeShared<FJsonObject>();
+		SectionObject->SetStringField(TEXT("culture"), Section.Culture);
+		SectionObject->SetObjectField(TEXT("texts"), Texts);
+		Cultures->SetStringField(Section.Culture, Written(PutObject(ToJson(SectionObject))));
+	}
+
+	TArray<FString> EntryChunkHashes;
+	bAllObjectsWritten &= PutEntryTable(EntryHashes, /*out*/ EntryChunkHashes);
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("formatVersion"), FormatVersion);
+	Root->SetNumberField(TEXT("manifestFormatVersion"), Manifest.FormatVersion);
+	Root->SetArrayField(TEXT("entryChunks"), ToJsonArray(EntryChunkHashes));
+	Root->SetObjectField(TEXT("cultures"), Cultures);
+	const FString RootHash = Written(PutObject(ToJson(Root)));
+	if (!bAllObjectsWritten)
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to store build %s, some archive objects couldn't be written"), *BuildId);
+		return FString();
+	}
+
+	if (bAlreadyStored)
+	{
+		if (ExistingRootHash != RootHash)
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("Build %s is already archived with different contents (root %s), archived builds can't be replaced"), *BuildId, *ExistingRootHash);
+			return FString();
+		}
+		return RootHash;
+	}
+
+	// Append to the build index
+	TSharedPtr<FJsonObject> BuildsObject;
+	FString BuildsText;
+	if (FFileHelper::LoadFileToString(/*out*/ BuildsText, *GetBuildsFilename()))
+	{
+		BuildsObject = FromJson(BuildsText);
+	}
+	if (!BuildsObject.IsValid())
+	{
+		BuildsObject = MakeShared<FJsonObject>();
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Builds;
+	const TArray<TSharedPtr<FJsonValue>>* ExistingBuilds = nullptr;
+	if (BuildsObject->TryGetArrayField(TEXT("builds"), /*out*/ ExistingBuilds))
+	{
+		Builds = *ExistingBuilds;
+	}
+
+	TSharedRef<FJsonObject> BuildObject = MakeShared<FJsonObject>();
+	BuildObject->SetStringField(TEXT("id"), BuildId);
+	BuildObject->SetStringField(TEXT("root"), RootHash);
+	BuildObject->SetStringField(TEXT("storedAt"), FDateTime::UtcNow().ToIso8601());
+	Builds.Add(MakeShared<FJsonValueObject>(BuildObject));
+	BuildsObject->SetArrayField(TEXT("builds"), Builds);
+
+	// Written next to the index and moved over it, so a failed or interrupted write never leaves a truncated build list
+	const FString TempBuildsFilename = GetBuildsFilename() + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(ToJson(BuildsObject.ToSharedRef()), *TempBuildsFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM) ||
+		!IFileManager::Get().Move(*GetBuildsFilename(), *TempBuildsFilename, /*bReplace=*/ true))
+	{
+		IFileManager::Get().Delete(*TempBuildsFilename);
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to write %s"), *GetBuildsFilename());
+		return FString();
+	}
+
+	return RootHash;
+}
+
+TArray<TPair<FString, FString>> FJamLicenseManifestArchive::GetBuilds() const
+{
+	using namespace JamLicenseManifestArchive;
+
+	TArray<TPair<FString, FString>> Result;
+
+	FString BuildsText;
+	TSharedPtr<FJsonObject> BuildsObject = FFileHelper::LoadFileToString(/*out*/ BuildsText, *GetBuildsFilename()) ? FromJson(BuildsText) : nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* Builds = nullptr;
+	if (BuildsObject.IsValid() && BuildsObject->TryGetArrayField(TEXT("builds"), /*out*/ Builds))
+	{
+		for (const TSharedPtr<FJsonValue>& BuildValue : *Builds)
+		{
+			const TSharedPtr<FJsonObject> BuildObject = BuildValue->AsObject();
+			if (BuildObject.IsValid())
+			{
+				Result.Emplace(BuildObject->GetStringField(TEXT("id")), BuildObject->GetStringField(TEXT("root")));
+			}
+		}
+	}
+
+	return Result;
+}
+
+bool FJamLicenseManifestArchive::FindRootHash(const FString& BuildId, FString& OutRootHash, FString& OutError) const
+{
+	for (const TPair<FString, FString>& Build : GetBuilds())
+	{
+		if (Build.Key == BuildId)
+		{
+			OutRootHash = Build.Value;
+			return true;
+		}
+	}
+
+	OutError = FString::Printf(TEXT("Build %s is not in the archive at %s"), *BuildId, *ArchiveDir);
+	return false;
+}
+
+bool FJamLicenseManifestArchive::LoadBuild(const FString& BuildId, FJamLicenseManifest& OutManifest, FString& OutError) const
+{
+	using namespace JamLicenseManifestArchive;
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	FString RootHash;
+	if (!FindRootHash(BuildId, /*out*/ RootHash, /*out*/ OutError))
+	{
+		return false;
+	}
+
+	FString RootText;
+	TSharedPtr<FJsonObject> Root = GetObject(RootHash, /*out*/ RootText) ? FromJson(RootText) : nullptr;
+	if (!Root.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Root object %s of build %s is missing or corrupt"), *RootHash, *BuildId);
+		return false;
+	}
+
+	OutManifest = FJamLicenseManifest();
+	OutManifest.FormatVersion = Root->GetIntegerField(TEXT("manifestFormatVersion"));
+	ReadHashMap(Root, TEXT("cultures")).GenerateKeyArray(/*out*/ OutManifest.Cultures);
+
+	TMap<FString, FString> EntryHashes;
+	if (!GetEntryTable(Root, TSet<FString>(), /*out*/ EntryHashes))
+	{
+		OutError = FString::Printf(TEXT("The entry table of build %s is missing or corrupt"), *BuildId);
+		return false;
+	}
+
+	for (const TPair<FString, FString>& Pair : EntryHashes)
+	{
+		FString EntryText;
+		TSharedPtr<FJsonObject> EntryObject = GetObject(Pair.Value, /*out*/ EntryText) ? FromJson(EntryText) : nullptr;
+		if (!EntryObject.IsValid())
+		{
+			OutError = FString::Printf(TEXT("Entry object %s of build %s is missing or corrupt"), *Pair.Value, *BuildId);
+			return false;
+		}
+
+		FJamLicenseManifestEntry& Entry = OutManifest.Licenses.AddDefaulted_GetRef();
+		Entry.AssetSourceURL = EntryObject->GetStringField(TEXT("url"));
+		Entry.LicenseAsset = EntryObject->GetStringField(TEXT("licenseAsset"));
+		Entry.SPDXIdentifier = EntryObject->GetStringField(TEXT("spdx"));
+		for (const TSharedPtr<FJsonValue>& PlatformValue : EntryObject->GetArrayField(TEXT("platforms")))
+		{
+			Entry.AllowedPlatforms.Add(FName(*PlatformValue->AsString()));
+		}
+
+		if (!GetObject(EntryObject->GetStringField(TEXT("text")), /*out*/ Entry.LicenseText) ||
+			!GetPackages(EntryObject->GetStringField(TEXT("packages")), /*out*/ Entry.Packages))
+		{
+			OutError = FString::Printf(TEXT("Objects referenced by %s in build %s are missing"), *Entry.AssetSourceURL, *BuildId);
+			return false;
+		}
+	}
+
+	OutManifest.Normalize();
+	return true;
+}
+
+bool FJamLicenseManifestArchive::Diff(const FString& FromBuildId, const FString& ToBuildId, FJamLicenseManifestDiff& OutDiff, FString& OutError) const
+{
+	using namespace JamLicenseManifestArchive;
+
+	OutDiff = FJamLicenseManifestDiff();
+
+	FString FromRootHash;
+	FString ToRootHash;
+	if (!FindRootHash(FromBuildId, /*out*/ FromRootHash, /*out*/ OutError) || !FindRootHash(ToBuildId, /*out*/ ToRootHash, /*out*/ OutError))
+	{
+		return false;
+	}
+
+	if (FromRootHash == ToRootHash)
+	{
+		return true;
+	}
+
+	FString FromText;
+	FString ToText;
+	TSharedPtr<FJsonObject> FromRoot = GetObject(FromRootHash, /*out*/ FromText) ? FromJson(FromText) : nullptr;
+	TSharedPtr<FJsonObject> ToRoot = GetObject(ToRootHash, /*out*/ ToText) ? FromJson(ToText) : nullptr;
+	if (!FromRoot.IsValid() || !ToRoot.IsValid())
+	{
+		OutError = TEXT("A root object is missing or corrupt");
+		return false;
+	}
+
+	// Entry table chunks both builds share hold identical entries, so only the others are read
+	const TArray<FString> FromChunkHashes = GetEntryChunkHashes(FromRoot);
+	const TSet<FString> SharedChunks = TSet<FString>(FromChunkHashes).Intersect(TSet<FString>(GetEntryChunkHashes(ToRoot)));
+
+	TMap<FString, FString> FromEntries;
+	TMap<FString, FString> ToEntries;
+	if (!GetEntryTable(FromRoot, SharedChunks, /*out*/ FromEntries) || !GetEntryTable(ToRoot, SharedChunks, /*out*/ ToEntries))
+	{
+		OutError = TEXT("An entry table is missing or corrupt");
+		return false;
+	}
+
+	for (const TPair<FString, FString>& Pair : FromEntries)
+	{
+		if (!ToEntries.Contains(Pair.Key))
+		{
+			OutDiff.RemovedURLs.Add(Pair.Key);
+		}
+	}
+
+	for (const TPair<FString, FString>& Pair : ToEntries)
+	{
+		const FString* pFromHash = FromEntries.Find(Pair.Key);
+		if (pFromHash == nullptr)
+		{
+			OutDiff.AddedURLs.Add(Pair.Key);
+			continue;
+		}
+
+		// Identical entries have identical hashes, so only changed entries are loaded
+		if (*pFromHash == Pair.Value)
+		{
+			continue;
+		}
+
+		FString FromEntryText;
+		FString ToEntryText;
+		TSharedPtr<FJsonObject> FromEntry = GetObject(*pFromHash, /*out*/ FromEntryText) ? FromJson(FromEntryText) : nullptr;
+		TSharedPtr<FJsonObject> ToEntry = GetObject(Pair.Value, /*out*/ ToEntryText) ? FromJson(ToEntryText) : nullptr;
+		if (!FromEntry.IsValid() || !ToEntry.IsValid())
+		{
+			OutError = FString::Printf(TEXT("Entry objects for %s are missing or corrupt"), *Pair.Key);
+			return false;
+		}
+
+		FJamLicenseManifestDiff::FChangedLicense& Changed = OutDiff.ChangedLicenses.AddDefaulted_GetRef();
+		Changed.AssetSourceURL = Pair.Key;
+		Changed.bLicenseAssetChanged = FromEntry->GetStringField(TEXT("licenseAsset")) != ToEntry->GetStringField(TEXT("licenseAsset"));
+		Changed.bSPDXChanged = FromEntry->GetStringField(TEXT("spdx")) != ToEntry->GetStringField(TEXT("spdx"));
+		Changed.bTextChanged = FromEntry->GetStringField(TEXT("text")) != ToEntry->GetStringField(TEXT("text"));
+
+		TArray<FString> FromPlatforms;
+		TArray<FString> ToPlatforms;
+		FromEntry->TryGetStringArrayField(TEXT("platforms"), /*out*/ FromPlatforms);
+		ToEntry->TryGetStringArrayField(TEXT("platforms"), /*out*/ ToPlatforms);
+		Changed.bPlatformsChanged = FromPlatforms != ToPlatforms;
+
+		const FString FromPackagesHash = FromEntry->GetStringField(TEXT("packages"));
+		const FString ToPackagesHash = ToEntry->GetStringField(TEXT("packages"));
+		if (FromPackagesHash != ToPackagesHash)
+		{
+			TArray<FName> FromPackages;
+			TArray<FName> ToPackages;
+			if (!GetPackages(FromPackagesHash, /*out*/ FromPackages) || !GetPackages(ToPackagesHash, /*out*/ ToPackages))
+			{
+				OutError = FString::Printf(TEXT("Package lists for %s are missing or corrupt"), *Pair.Key);
+				return false;
+			}
+
+			const TSet<FName> FromSet(FromPackages);
+			const TSet<FName> ToSet(ToPackages);
+			for (FName Package : ToPackages)
+			{
+				if (!FromSet.Contains(Package))
+				{
+					Changed.AddedPackages.Add(Package);
+				}
+			}
+			for (FName Package : FromPackages)
+			{
+				if (!ToSet.Contains(Package))
+				{
+					Changed.RemovedPackages.Add(Package);
+				}
+			}
+		}
+	}
+
+	const TMap<FString, FString> FromCultures = ReadHashMap(FromRoot, TEXT("cultures"));
+	const TMap<FString, FString> ToCultures = ReadHashMap(ToRoot, TEXT("cultures"));
+	for (const TPair<FString, FString>& Pair : ToCultures)
+	{
+		const FString* pFromHash = FromCultures.Find(Pair.Key);
+		if ((pFromHash == nullptr) || (*pFromHash != Pair.Value))
+		{
+			OutDiff.ChangedCultures.Add(Pair.Key);
+		}
+	}
+	for (const TPair<FString, FString>& Pair : FromCultures)
+	{
+		if (!ToCultures.Contains(Pair.Key))
+		{
+			OutDiff.ChangedCultures.Add(Pair.Key);
+		}
+	}
+
+	OutDiff.AddedURLs.Sort();
+	OutDiff.RemovedURLs.Sort();
+	OutDiff.ChangedCultures.Sort();
+	return true;
+}
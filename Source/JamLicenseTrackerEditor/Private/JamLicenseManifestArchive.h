@@ -0,0 +1,111 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+struct FJamLicenseManifest;
+struct FJamLicenseManifestCultureSection;
+
+// The differences between the license manifests of two archived builds
+struct FJamLicenseManifestDiff
+{
+	struct FChangedLicense
+	{
+		FString AssetSourceURL;
+
+		// Which parts of the entry differ
+		bool bLicenseAssetChanged = false;
+		bool bSPDXChanged = false;
+		bool bPlatformsChanged = false;
+		bool bTextChanged = false;
+
+		TArray<FName> AddedPackages;
+		TArray<FName> RemovedPackages;
+	};
+
+	TArray<FString> AddedURLs;
+	TArray<FString> RemovedURLs;
+	TArray<FChangedLicense> ChangedLicenses;
+
+	// Cultures whose localized texts differ (including cultures added or removed)
+	TArray<FString> ChangedCultures;
+
+	bool IsEmpty() const
+	{
+		return (AddedURLs.Num() == 0) && (RemovedURLs.Num() == 0) && (ChangedLicenses.Num() == 0) && (ChangedCultures.Num() == 0);
+	}
+};
+
+// A content-addressed store of the license manifests of shipped builds
+//
+// Every piece of a manifest is stored as an immutable object named by the SHA-1 of its contents (under objects/),
+// so anything that didn't change between builds is shared rather than stored again:
+//   - license texts are stored once per distinct text
+//   - package lists are split into content-defined chunks (a boundary after each name whose hash has its low
+//     6 bits clear), so adding or removing a few packages only produces a couple of new chunks
+//   - each license entry references its text and package chunks by hash
+//   - the URL -> entry hash table is chunked by URL the same way, so a new build only stores the chunks holding
+//     entries that changed, plus a root listing the chunk hashes (about one per 64 licenses) and culture sections
+// builds.json maps each build id to its root hash. Diffing two builds skips the entry table chunks they share and
+// then compares entry hashes, so only the entries that actually changed are ever loaded
+class FJamLicenseManifestArchive
+{
+public:
+	explicit FJamLicenseManifestArchive(const FString& InArchiveDir);
+
+	// Returns the default archive location
+	static FString GetDefaultDirectory();
+
+	// Stores a manifest (and its culture sections) under a build id, returning the root hash or an empty string on failure
+	FString StoreBuild(const FString& BuildId, const FJamLicenseManifest& Manifest, const TArray<FJamLicenseManifestCultureSection>& CultureSections);
+
+	// Reconstructs the manifest of an archived build
+	bool LoadBuild(const FString& BuildId, FJamLicenseManifest& OutManifest, FString& OutError) const;
+
+	bool Diff(const FString& FromBuildId, const FString& ToBuildId, FJamLicenseManifestDiff& OutDiff, FString& OutError) const;
+
+	// Returns every archived build id and its root hash, in the order they were stored
+	TArray<TPair<FString, FString>> GetBuilds() const;
+
+private:
+	// Writes an object unless it already exists, returning its hash or an empty string on failure
+	FString PutObject(const FString& Contents);
+	bool GetObject(const FString& Hash, FString& OutContents) const;
+
+	// Returns an empty string if any chunk failed to write
+	// Writes the URL -> entry hash table as content-defined chunks, in the order given
+	bool PutEntryTable(const TArray<TPair<FString, FString>>& EntryHashes, TArray<FString>& OutChunkHashes);
+
+	// Reads the URL -> entry hash table of a root, skipping any chunks in ChunksToSkip
+	bool GetEntryTable(const TSharedPtr<FJsonObject>& Root, const TSet<FString>& ChunksToSkip, TMap<FString, FString>& OutEntryHashes) const;
+
+	FString PutPackages(const TArray<FName>& Packages);
+	bool GetPackages(const FString& Hash, TArray<FName>& OutPackages) const;
+
+	bool FindRootHash(const FString& BuildId, FString& OutRootHash, FString& OutError) const;
+	FString GetObjectFilename(const FString& Hash) const;
+	FString GetBuildsFilename() const;
+
+private:
+	FString ArchiveDir;
+};
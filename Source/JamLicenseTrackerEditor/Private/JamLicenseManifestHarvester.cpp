@@ -0,0 +1,138 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseManifestHarvester.h"
+
+#include "JamAssetLicense.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseManifest.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "AssetData.h"
+#include "IAssetRegistry.h"
+
+bool FJamLicenseManifestHarvester::Harvest(FJamLicenseManifest& OutManifest, TArray<FJamLicenseManifestCultureSection>& OutCultureSections)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const FName NAME_AssetSourceURL(MD_AssetSourceURL);
+	const FName LicenseClassName = UJamAssetLicense::StaticClass()->GetFName();
+
+	OutManifest = FJamLicenseManifest();
+	OutCultureSections.Reset();
+
+	TMap<FString, int32> CultureToSection;
+
+	// Packages are gathered into sets first, since multi-asset packages show up once per asset
+	TMap<FString, int32> URLToEntry;
+	TArray<TSet<FName>> PackagesPerEntry;
+	auto FindOrAddEntry = [&](const FString& URL) -> int32
+	{
+		if (const int32* pIndex = URLToEntry.Find(URL))
+		{
+			return *pIndex;
+		}
+
+		const int32 NewIndex = OutManifest.Licenses.AddDefaulted();
+		OutManifest.Licenses[NewIndex].AssetSourceURL = URL;
+		PackagesPerEntry.AddDefaulted();
+		URLToEntry.Add(URL, NewIndex);
+		return NewIndex;
+	};
+
+	// Licensed packages, straight from tags
+	TArray<FAssetData> TaggedAssets;
+	AssetRegistry.GetAssetsByTags({ NAME_AssetSourceURL }, /*out*/ TaggedAssets);
+
+	for (const FAssetData& AssetData : TaggedAssets)
+	{
+		if (AssetData.AssetClass == LicenseClassName)
+		{
+			continue;
+		}
+
+		FString URL;
+		if (AssetData.GetTagValue(NAME_AssetSourceURL, /*out*/ URL) && !URL.IsEmpty())
+		{
+			PackagesPerEntry[FindOrAddEntry(URL)].Add(AssetData.PackageName);
+		}
+	}
+
+	// The license assets are small, so load them for their text (the first by object path wins if several cover the same URL)
+	TArray<FAssetData> LicenseAssets;
+	AssetRegistry.GetAssetsByClass(LicenseClassName, /*out*/ LicenseAssets);
+	LicenseAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.ObjectPath.LexicalLess(B.ObjectPath); });
+
+	bool bSuccess = true;
+	for (const FAssetData& LicenseData : LicenseAssets)
+	{
+		const FString URL = LicenseData.GetTagValueRef<FString>(NAME_AssetSourceURL);
+		if (URL.IsEmpty())
+		{
+			continue;
+		}
+
+		FJamLicenseManifestEntry& Entry = OutManifest.Licenses[FindOrAddEntry(URL)];
+		if (!Entry.LicenseAsset.IsEmpty())
+		{
+			continue;
+		}
+
+		UJamAssetLicense* License = Cast<UJamAssetLicense>(LicenseData.GetAsset());
+		if (License == nullptr)
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to load license asset %s"), *LicenseData.ObjectPath.ToString());
+			bSuccess = false;
+			continue;
+		}
+
+		Entry.LicenseAsset = LicenseData.ObjectPath.ToString();
+		Entry.SPDXIdentifier = License->SPDXIdentifier;
+		Entry.AllowedPlatforms = License->AllowedPlatforms;
+		Entry.LicenseText = License->LicenseText;
+
+		for (const TPair<FString, FString>& Variant : License->LocalizedLicenseText)
+		{
+			if (Variant.Key.IsEmpty())
+			{
+				continue;
+			}
+
+			int32& SectionIndex = CultureToSection.FindOrAdd(Variant.Key, INDEX_NONE);
+			if (SectionIndex == INDEX_NONE)
+			{
+				SectionIndex = OutCultureSections.AddDefaulted();
+				OutCultureSections[SectionIndex].Culture = Variant.Key;
+				OutManifest.Cultures.Add(Variant.Key);
+			}
+			OutCultureSections[SectionIndex].LicenseTextByURL.Add(URL, Variant.Value);
+		}
+	}
+
+	for (int32 EntryIndex = 0; EntryIndex < OutManifest.Licenses.Num(); ++EntryIndex)
+	{
+		OutManifest.Licenses[EntryIndex].Packages = PackagesPerEntry[EntryIndex].Array();
+	}
+
+	OutManifest.Normalize();
+	return bSuccess;
+}
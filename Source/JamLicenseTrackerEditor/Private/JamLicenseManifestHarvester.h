@@ -0,0 +1,36 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FJamLicenseManifest;
+struct FJamLicenseManifestCultureSection;
+
+// Builds license manifests from the asset registry
+class FJamLicenseManifestHarvester
+{
+public:
+	// Fills in the manifest from the current asset registry state (which should be fully scanned first), loading
+	// only the license assets themselves to pick up their text. Localized license texts go into one section per
+	// culture. Returns false if any license asset failed to load
+	static bool Harvest(FJamLicenseManifest& OutManifest, TArray<FJamLicenseManifestCultureSection>& OutCultureSections);
+};
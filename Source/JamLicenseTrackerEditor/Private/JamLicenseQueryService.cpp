@@ -0,0 +1,449 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseQueryService.h"
+
+#include "JamLicenseIndex.h"
+#include "JamLicenseMemory.h"
+
+#include "IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/PackageName.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+static const TCHAR* LexToString(EJamLicenseState State)
+{
+	switch (State)
+	{
+	case EJamLicenseState::NoSource: return TEXT("NoSource");
+	case EJamLicenseState::SourceWithoutLicense: return TEXT("SourceWithoutLicense");
+	case EJamLicenseState::Licensed: return TEXT("Licensed");
+	}
+	return TEXT("Unknown");
+}
+
+static TSharedRef<FJsonObject> MakeError(const FString& Message)
+{
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("error"), Message);
+	return Result;
+}
+
+static TSharedRef<FJsonValue> MakeNameArray(const TArray<FName>& Names, int32 Limit = MAX_int32)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	Values.Reserve(FMath::Min(Names.Num(), Limit));
+	for (int32 Index = 0; Index < FMath::Min(Names.Num(), Limit); ++Index)
+	{
+		Values.Add(MakeShared<FJsonValueString>(Names[Index].ToString()));
+	}
+	return MakeShared<FJsonValueArray>(Values);
+}
+
+FJamLicenseQueryService::FJamLicenseQueryService()
+{
+	MemoryReportHandle = FJamLicenseMemoryReport::OnGather().AddRaw(this, &FJamLicenseQueryService::GatherMemoryUsage);
+}
+
+FJamLicenseQueryService::~FJamLicenseQueryService()
+{
+	FJamLicenseMemoryReport::OnGather().Remove(MemoryReportHandle);
+}
+
+void FJamLicenseQueryService::GatherMemoryUsage(FJamLicenseMemoryReport& Report) const
+{
+	FJamLicenseMemoryUsage Usage;
+	Usage.Caches += PackageToURLIds.GetAllocatedSize() + AssetsByURLId.GetAllocatedSize() + ClosureCache.GetAllocatedSize();
+	for (const TPair<FName, TArray<int32, TInlineAllocator<1>>>& Pair : PackageToURLIds)
+	{
+		Usage.Caches += Pair.Value.GetAllocatedSize();
+	}
+	for (const TArray<FName>& Assets : AssetsByURLId)
+	{
+		Usage.Caches += Assets.GetAllocatedSize();
+	}
+	for (const TPair<FName, TArray<FName>>& Pair : ClosureCache)
+	{
+		Usage.Caches += Pair.Value.GetAllocatedSize();
+	}
+	Report.Add(TEXT("QueryService"), Usage);
+}
+
+FString FJamLicenseQueryService::HandleRequest(const FString& RequestText)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TSharedPtr<FJsonObject> Request;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RequestText);
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	if (!FJsonSerializer::Deserialize(Reader, /*out*/ Request) || !Request.IsValid())
+	{
+		Results.Add(MakeShared<FJsonValueObject>(MakeError(TEXT("Request is not a JSON object"))));
+	}
+	else
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Queries = nullptr;
+		if (!Request->TryGetArrayField(TEXT("queries"), /*out*/ Queries))
+		{
+			Results.Add(MakeShared<FJsonValueObject>(MakeError(TEXT("Request has no queries array"))));
+		}
+		else
+		{
+			Results.Reserve(Queries->Num());
+			for (const TSharedPtr<FJsonValue>& QueryValue : *Queries)
+			{
+				const TSharedPtr<FJsonObject>* Query = nullptr;
+				Results.Add(MakeShared<FJsonValueObject>((QueryValue.IsValid() && QueryValue->TryGetObject(/*out*/ Query)) ? HandleQuery(**Query) : MakeError(TEXT("Query is not a JSON object"))));
+			}
+		}
+	}
+
+	TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetNumberField(TEXT("version"), FJamLicenseIndex::Get().GetVersion());
+	Response->SetNumberField(TEXT("elapsedMs"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	Response->SetArrayField(TEXT("results"), Results);
+
+	FString ResponseText;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ResponseText);
+	FJsonSerializer::Serialize(Response, Writer);
+	return ResponseText;
+}
+
+void FJamLicenseQueryService::InvalidateClosures()
+{
+	ClosureCache.Reset();
+}
+
+TSharedRef<FJsonObject> FJamLicenseQueryService::HandleQuery(const FJsonObject& Query)
+{
+	const FString Op = Query.GetStringField(TEXT("op"));
+	if (Op == TEXT("stats"))
+	{
+		return QueryStats();
+	}
+	else if (Op == TEXT("asset"))
+	{
+		return QueryAssets(Query);
+	}
+	else if (Op == TEXT("url"))
+	{
+		return QueryURL(Query);
+	}
+	else if (Op == TEXT("closure"))
+	{
+		return QueryClosure(Query);
+	}
+	else if (Op == TEXT("unlicensed"))
+	{
+		return QueryUnlicensed();
+	}
+	else if (Op == TEXT("folder"))
+	{
+		return QueryFolder(Query);
+	}
+	else if (Op == TEXT("shutdown"))
+	{
+		bShutdownRequested = true;
+		return MakeShared<FJsonObject>();
+	}
+
+	return MakeError(FString::Printf(TEXT("Unknown op '%s'"), *Op));
+}
+
+void FJamLicenseQueryService::RefreshPackageTablesIfNeeded()
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	if (PackageTablesVersion == Index.GetVersion())
+	{
+		return;
+	}
+
+	PackageTablesVersion = Index.GetVersion();
+	PackageToURLIds.Reset();
+	AssetsByURLId.Reset();
+	AssetsByURLId.SetNum(Index.GetNumURLIds());
+
+	for (const TPair<FName, int32>& Pair : Index.GetAssetURLIds())
+	{
+		const FName PackageName(*FPackageName::ObjectPathToPackageName(Pair.Key.ToString()));
+		PackageToURLIds.FindOrAdd(PackageName).AddUnique(Pair.Value);
+		AssetsByURLId[Pair.Value].Add(Pair.Key);
+	}
+
+	for (TArray<FName>& Assets : AssetsByURLId)
+	{
+		Assets.Sort(FNameLexicalLess());
+	}
+}
+
+const TArray<FName>& FJamLicenseQueryService::GetClosure(FName PackageName)
+{
+	if (const TArray<FName>* pCached = ClosureCache.Find(PackageName))
+	{
+		++NumClosureHits;
+		return *pCached;
+	}
+	++NumClosureMisses;
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FName> Closure;
+	TSet<FName> Visited;
+	Visited.Add(PackageName);
+	Closure.Add(PackageName);
+
+	// Packages pulled in from an already cached closure have had their dependencies added with them
+	TSet<FName> AlreadyExpanded;
+
+	auto AddToClosure = [&Closure, &Visited](FName Dependency)
+	{
+		bool bAlreadyVisited = false;
+		Visited.Add(Dependency, &bAlreadyVisited);
+		if (!bAlreadyVisited)
+		{
+			Closure.Add(Dependency);
+		}
+	};
+
+	TArray<FName> Dependencies;
+	for (int32 Cursor = 0; Cursor < Closure.Num(); ++Cursor)
+	{
+		const FName Current = Closure[Cursor];
+		if (AlreadyExpanded.Contains(Current))
+		{
+			continue;
+		}
+
+		if (const TArray<FName>* pSubClosure = (Cursor > 0) ? ClosureCache.Find(Current) : nullptr)
+		{
+			for (FName Dependency : *pSubClosure)
+			{
+				AddToClosure(Dependency);
+			}
+			AlreadyExpanded.Append(*pSubClosure);
+			continue;
+		}
+
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(Current, /*out*/ Dependencies);
+		for (FName Dependency : Dependencies)
+		{
+			if (!FPackageName::IsScriptPackage(Dependency.ToString()))
+			{
+				AddToClosure(Dependency);
+			}
+		}
+	}
+
+	return ClosureCache.Add(PackageName, MoveTemp(Closure));
+}
+
+TSharedRef<FJsonObject> FJamLicenseQueryService::MakeURLObject(int32 URLId)
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	const FJamLicenseURLSortData& SortData = Index.GetURLSortData();
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("url"), Index.GetURL(URLId));
+	Result->SetStringField(TEXT("state"), LexToString(Index.HasLicenseAsset(URLId) ? EJamLicenseState::Licensed : EJamLicenseState::SourceWithoutLicense));
+	if (!SortData.LicenseAsset[URLId].IsNone())
+	{
+		Result->SetStringField(TEXT("license"), SortData.LicenseAsset[URLId].ToString());
+		Result->SetStringField(TEXT("spdx"), SortData.SPDXIdentifier[URLId]);
+	}
+	return Result;
+}
+
+TSharedRef<FJsonObject> FJamLicenseQueryService::QueryStats()
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+
+	int32 NumURLsInUse = 0;
+	int32 NumLicensedURLs = 0;
+	for (int32 URLId = 0; URLId < Index.GetNumURLIds(); ++URLId)
+	{
+		if (Index.GetNumAssetsUsingURL(URLId) > 0)
+		{
+			++NumURLsInUse;
+			NumLicensedURLs += Index.HasLicenseAsset(URLId) ? 1 : 0;
+		}
+	}
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("assetsWithURL"), Index.GetAssetURLIds().Num());
+	Result->SetNumberField(TEXT("urls"), NumURLsInUse);
+	Result->SetNumberField(TEXT("licensedUrls"), NumLicensedURLs);
+	Result->SetNumberField(TEXT("cachedClosures"), ClosureCache.Num());
+	Result->SetNumberField(TEXT("closureHits"), (double)NumClosureHits);
+	Result->SetNumberField(TEXT("closureMisses"), (double)NumClosureMisses);
+	return Result;
+}
+
+TSharedRef<FJsonObject> FJamLicenseQueryService::QueryAssets(const FJsonObject& Query)
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	RefreshPackageTablesIfNeeded();
+
+	const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
+	if (!Query.TryGetArrayField(TEXT("paths"), /*out*/ Paths))
+	{
+		return MakeError(TEXT("asset needs a paths array"));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Assets;
+	Assets.Reserve(Paths->Num());
+	for (const TSharedPtr<FJsonValue>& PathValue : *Paths)
+	{
+		const FString Path = PathValue->AsString();
+
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("path"), Path);
+
+		TArray<TSharedPtr<FJsonValue>> URLs;
+		if (Path.Contains(TEXT(".")))
+		{
+			const int32 URLId = Index.GetAssetURLId(FName(*Path));
+			if (URLId != INDEX_NONE)
+			{
+				URLs.Add(MakeShared<FJsonValueObject>(MakeURLObject(URLId)));
+			}
+		}
+		else if (const auto* pURLIds = PackageToURLIds.Find(FName(*Path)))
+		{
+			for (int32 URLId : *pURLIds)
+			{
+				URLs.Add(MakeShared<FJsonValueObject>(MakeURLObject(URLId)));
+			}
+		}
+
+		Entry->SetArrayField(TEXT("urls"), URLs);
+		Assets.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetArrayField(TEXT("assets"), Assets);
+	return Result;
+}
+
+TSharedRef<FJsonObject> FJamLicenseQueryService::QueryURL(const FJsonObject& Query)
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	RefreshPackageTablesIfNeeded();
+
+	const int32 URLId = Index.FindURLId(Query.GetStringField(TEXT("url")));
+	if (URLId == INDEX_NONE)
+	{
+		return MakeError(TEXT("No asset or license uses that URL"));
+	}
+
+	int32 Limit = 100;
+	Query.TryGetNumberField(TEXT("limit"), /*out*/ Limit);
+
+	TSharedRef<FJsonObject> Result = MakeURLObject(URLId);
+	Result->SetNumberField(TEXT("numAssets"), Index.GetNumAssetsUsingURL(URLId));
+	Result->SetField(TEXT("assets"), MakeNameArray(AssetsByURLId[URLId], Limit));
+	return Result;
+}
+
+TSharedRef<FJsonObject> FJamLicenseQueryService::QueryClosure(const FJsonObject& Query)
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	RefreshPackageTablesIfNeeded();
+
+	const TArray<TSharedPtr<FJsonValue>>* Packages = nullptr;
+	if (!Query.TryGetArrayField(TEXT("packages"), /*out*/ Packages))
+	{
+		return MakeError(TEXT("closure needs a packages array"));
+	}
+
+	TSet<FName> AllPackages;
+	for (const TSharedPtr<FJsonValue>& PackageValue : *Packages)
+	{
+		AllPackages.Append(GetClosure(FName(*PackageValue->AsString())));
+	}
+
+	TSet<int32> URLIds;
+	for (FName PackageName : AllPackages)
+	{
+		if (const auto* pURLIds = PackageToURLIds.Find(PackageName))
+		{
+			URLIds.Append(*pURLIds);
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> URLs;
+	TArray<TSharedPtr<FJsonValue>> Unlicensed;
+	for (int32 URLId : URLIds)
+	{
+		URLs.Add(MakeShared<FJsonValueObject>(MakeURLObject(URLId)));
+		if (!Index.HasLicenseAsset(URLId))
+		{
+			Unlicensed.Add(MakeShared<FJsonValueString>(Index.GetURL(URLId)));
+		}
+	}
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("numPackages"), AllPackages.Num());
+	Result->SetArrayField(TEXT("urls"), URLs);
+	Result->SetArrayField(TEXT("unlicensed"), Unlicensed);
+	return Result;
+}
+
+TSharedRef<FJsonObject> FJamLicenseQueryService::QueryUnlicensed()
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+
+	TArray<TSharedPtr<FJsonValue>> URLs;
+	for (int32 URLId = 0; URLId < Index.GetNumURLIds(); ++URLId)
+	{
+		if ((Index.GetNumAssetsUsingURL(URLId) > 0) && !Index.HasLicenseAsset(URLId))
+		{
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("url"), Index.GetURL(URLId));
+			Entry->SetNumberField(TEXT("numAssets"), Index.GetNumAssetsUsingURL(URLId));
+			URLs.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+	}
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetArrayField(TEXT("urls"), URLs);
+	return Result;
+}
+
+TSharedRef<FJsonObject> FJamLicenseQueryService::QueryFolder(const FJsonObject& Query)
+{
+	const FString Path = Query.GetStringField(TEXT("path"));
+	const FJamLicenseFolderStats Stats = FJamLicenseIndex::Get().GetFolderStats(FName(*Path));
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("path"), Path);
+	Result->SetNumberField(TEXT("numAssets"), Stats.NumAssets);
+	Result->SetNumberField(TEXT("numAssetsWithURL"), Stats.NumAssetsWithURL);
+	Result->SetNumberField(TEXT("numAssetsWithLicense"), Stats.NumAssetsWithLicense);
+	Result->SetNumberField(TEXT("numDistinctURLs"), Stats.NumDistinctURLs);
+	Result->SetNumberField(TEXT("coverage"), Stats.GetCoverage());
+	return Result;
+}
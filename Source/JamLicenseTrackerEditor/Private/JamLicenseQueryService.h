@@ -0,0 +1,99 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FJsonValue;
+class FJamLicenseMemoryReport;
+
+// Answers batched license queries against FJamLicenseIndex, used by the JamLicenseServe commandlet
+//
+// A request is a JSON object holding an array of queries, each with an "op" and its arguments:
+//   {"queries": [{"op": "asset", "paths": ["/Game/Props/SM_Crate.SM_Crate", "/Game/Maps/Entry"]},
+//                {"op": "closure", "packages": ["/Game/Maps/Entry"]}]}
+// and the response holds one result object per query, in order (or {"error": "..."} for a query that failed):
+//   {"version": 12, "elapsedMs": 0.4, "results": [{...}, {...}]}
+//
+// Ops:
+//   stats                          Index version, totals and closure cache hit counts
+//   asset      paths[]             Source URL and license state of assets (object paths) or packages (package names)
+//   url        url, limit          License for a URL and the assets using it (up to limit, default 100)
+//   closure    packages[]          Every source URL used by the packages and everything they depend on
+//   unlicensed                     Every URL in use that has no license asset
+//   folder     path                Coverage totals for a content folder
+//   shutdown                       Stops the service after this request
+//
+// Package to URL tables and dependency closures are cached between requests, keyed on the index version
+// (for URLs) or until InvalidateClosures is called (for dependencies)
+class FJamLicenseQueryService
+{
+public:
+	FJamLicenseQueryService();
+	~FJamLicenseQueryService();
+
+	// Answers one request, returning the response as a single line of JSON
+	FString HandleRequest(const FString& RequestText);
+
+	// Drops cached dependency closures, call after the asset registry has picked up changed packages
+	void InvalidateClosures();
+
+	bool IsShutdownRequested() const
+	{
+		return bShutdownRequested;
+	}
+
+private:
+	TSharedRef<FJsonObject> HandleQuery(const FJsonObject& Query);
+
+	TSharedRef<FJsonObject> QueryStats();
+	TSharedRef<FJsonObject> QueryAssets(const FJsonObject& Query);
+	TSharedRef<FJsonObject> QueryURL(const FJsonObject& Query);
+	TSharedRef<FJsonObject> QueryClosure(const FJsonObject& Query);
+	TSharedRef<FJsonObject> QueryUnlicensed();
+	TSharedRef<FJsonObject> QueryFolder(const FJsonObject& Query);
+
+	// Describes a URL id (the URL, its license asset and state)
+	TSharedRef<FJsonObject> MakeURLObject(int32 URLId);
+
+	void RefreshPackageTablesIfNeeded();
+	const TArray<FName>& GetClosure(FName PackageName);
+
+	void GatherMemoryUsage(FJamLicenseMemoryReport& Report) const;
+
+private:
+	// Index version the package tables were built for
+	uint32 PackageTablesVersion = 0;
+
+	// URL ids used by the assets in each package, and the assets using each URL id
+	TMap<FName, TArray<int32, TInlineAllocator<1>>> PackageToURLIds;
+	TArray<TArray<FName>> AssetsByURLId;
+
+	// Dependency closure (including the root) of every package that has been asked about
+	TMap<FName, TArray<FName>> ClosureCache;
+	int64 NumClosureHits = 0;
+	int64 NumClosureMisses = 0;
+
+	bool bShutdownRequested = false;
+
+	FDelegateHandle MemoryReportHandle;
+};
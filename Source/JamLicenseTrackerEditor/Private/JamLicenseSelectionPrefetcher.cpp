@@ -0,0 +1,149 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseSelectionPrefetcher.h"
+
+#include "JamLicenseIndex.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseSelectionSummary.h"
+#include "JamLicenseTrackerSettings.h"
+
+#include "AssetData.h"
+#include "Async/Async.h"
+#include "ContentBrowserModule.h"
+#include "Modules/ModuleManager.h"
+
+static TUniquePtr<FJamLicenseSelectionPrefetcher> GJamLicenseSelectionPrefetcher;
+
+void FJamLicenseSelectionPrefetcher::Initialize()
+{
+	check(!GJamLicenseSelectionPrefetcher.IsValid());
+	GJamLicenseSelectionPrefetcher.Reset(new FJamLicenseSelectionPrefetcher());
+}
+
+void FJamLicenseSelectionPrefetcher::Shutdown()
+{
+	GJamLicenseSelectionPrefetcher.Reset();
+}
+
+FJamLicenseSelectionPrefetcher::FJamLicenseSelectionPrefetcher()
+{
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+	ContentBrowserModule.GetOnAssetSelectionChanged().AddRaw(this, &FJamLicenseSelectionPrefetcher::OnAssetSelectionChanged);
+}
+
+FJamLicenseSelectionPrefetcher::~FJamLicenseSelectionPrefetcher()
+{
+	if (FContentBrowserModule* ContentBrowserModule = FModuleManager::GetModulePtr<FContentBrowserModule>("ContentBrowser"))
+	{
+		ContentBrowserModule->GetOnAssetSelectionChanged().RemoveAll(this);
+	}
+
+	CancelPendingPrefetch();
+	if (PendingPrefetch.IsValid())
+	{
+		PendingPrefetch.Wait();
+	}
+}
+
+void FJamLicenseSelectionPrefetcher::CancelPendingPrefetch()
+{
+	if (PendingCancelFlag.IsValid())
+	{
+		*PendingCancelFlag = true;
+		PendingCancelFlag.Reset();
+	}
+}
+
+void FJamLicenseSelectionPrefetcher::OnAssetSelectionChanged(const TArray<FAssetData>& NewSelectedAssets, bool bIsPrimaryBrowser)
+{
+	// Whatever was being worked on is no longer interesting
+	CancelPendingPrefetch();
+
+	const UJamLicenseTrackerSettings* Settings = GetDefault<UJamLicenseTrackerSettings>();
+	if (!Settings->bPrefetchSelectionLicenseState || (NewSelectedAssets.Num() < Settings->MinSelectionSizeToPrefetch))
+	{
+		return;
+	}
+
+	// The key has to be built here, against the index version the tags are being read at
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	const bool bCheckForUnsavedEdits = Index.HasAnyUnsavedMetaDataEdits();
+
+	FJamLicenseSelectionKey Key;
+	Key.IndexVersion = Index.GetVersion();
+	for (const FAssetData& AssetData : NewSelectedAssets)
+	{
+		if (bCheckForUnsavedEdits && Index.HasUnsavedMetaDataEdits(AssetData.PackageName))
+		{
+			// The registry tags don't reflect the edit yet, so leave it to the context menu to read the metadata
+			return;
+		}
+
+		Key.AddAsset(AssetData.PackageName, AssetData.AssetName);
+	}
+
+	if (FJamLicenseSelectionCache::Find(Key).IsValid())
+	{
+		return;
+	}
+
+	TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> CancelFlag = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+	PendingCancelFlag = CancelFlag;
+
+	PendingPrefetch = Async(EAsyncExecution::ThreadPool, [Assets = NewSelectedAssets, Key, CancelFlag]()
+	{
+		LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+		FJamLicenseSelectionSummary Summary = ComputeFromAssetData(Assets, *CancelFlag);
+
+		// Don't publish a result if the selection changed again or something license-related happened in the meantime
+		if (!*CancelFlag && (FJamLicenseIndex::Get().GetVersion() == Key.IndexVersion))
+		{
+			FJamLicenseSelectionCache::Add(Key, MakeShared<FJamLicenseSelectionSummary>(MoveTemp(Summary)));
+		}
+	});
+}
+
+FJamLicenseSelectionSummary FJamLicenseSelectionPrefetcher::ComputeFromAssetData(const TArray<FAssetData>& Assets, const std::atomic<bool>& bCancelled)
+{
+	const FName NAME_AssetSourceURL(MD_AssetSourceURL);
+
+	FJamLicenseSelectionSummary Result;
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		if (((AssetIndex % 256) == 0) && bCancelled)
+		{
+			break;
+		}
+
+		FString URL;
+		if (Assets[AssetIndex].GetTagValue(NAME_AssetSourceURL, /*out*/ URL) && !URL.IsEmpty())
+		{
+			Result.URLUsageMap.FindOrAdd(URL) += 1;
+		}
+		else
+		{
+			++Result.NumAssetsWithNoURL;
+		}
+	}
+
+	return Result;
+}
@@ -0,0 +1,55 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+#include <atomic>
+
+struct FAssetData;
+struct FJamLicenseSelectionSummary;
+
+// Listens for Content Browser selection changes and summarizes the license state of large selections
+// on a worker thread (using asset registry tags), so the result is already in FJamLicenseSelectionCache
+// by the time the user right-clicks
+class FJamLicenseSelectionPrefetcher
+{
+public:
+	FJamLicenseSelectionPrefetcher();
+	~FJamLicenseSelectionPrefetcher();
+
+	static void Initialize();
+	static void Shutdown();
+
+	// Summarizes assets from their asset registry tags, stopping early if bCancelled becomes true (safe to call from any thread)
+	static FJamLicenseSelectionSummary ComputeFromAssetData(const TArray<FAssetData>& Assets, const std::atomic<bool>& bCancelled);
+
+private:
+	void OnAssetSelectionChanged(const TArray<FAssetData>& NewSelectedAssets, bool bIsPrimaryBrowser);
+
+	// Asks the in-flight prefetch (if any) to stop, without waiting for it; its result is never published
+	void CancelPendingPrefetch();
+
+private:
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> PendingCancelFlag;
+	TFuture<void> PendingPrefetch;
+};
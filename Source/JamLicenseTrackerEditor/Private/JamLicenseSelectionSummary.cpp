@@ -0,0 +1,190 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseSelectionSummary.h"
+
+#include "JamLicenseDiagnostics.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseMemory.h"
+
+#include "Misc/ScopeLock.h"
+#include "UObject/MetaData.h"
+#include "UObject/Package.h"
+
+FString FJamLicenseSelectionSummary::GetSharedURL() const
+{
+	if ((URLUsageMap.Num() == 1) && (NumAssetsWithNoURL == 0))
+	{
+		return URLUsageMap.CreateConstIterator().Key();
+	}
+
+	return FString();
+}
+
+FJamLicenseSelectionSummary FJamLicenseSelectionSummary::ComputeFromObjects(TArrayView<UObject* const> Objects)
+{
+	FJamLicenseSelectionSummary Result;
+
+	for (UObject* Obj : Objects)
+	{
+		if (UPackage* Package = Obj->GetOutermost())
+		{
+			if (UMetaData* Metadata = Package->HasMetaData() ? Package->GetMetaData() : nullptr)
+			{
+				const FString& LicenseAssetID = Metadata->GetValue(Obj, MD_AssetSourceURL);
+				if (!LicenseAssetID.IsEmpty())
+				{
+					Result.URLUsageMap.FindOrAdd(LicenseAssetID) += 1;
+				}
+				else
+				{
+					++Result.NumAssetsWithNoURL;
+				}
+			}
+			else
+			{
+				++Result.NumAssetsWithNoURL;
+			}
+		}
+	}
+
+	return Result;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+FJamLicenseSelectionKey FJamLicenseSelectionKey::FromObjects(TArrayView<UObject* const> Objects)
+{
+	FJamLicenseSelectionKey Result;
+	Result.IndexVersion = FJamLicenseIndex::Get().GetVersion();
+
+	for (UObject* Obj : Objects)
+	{
+		if (UPackage* Package = Obj->GetOutermost())
+		{
+			Result.AddAsset(Package->GetFName(), Obj->GetFName());
+		}
+	}
+
+	return Result;
+}
+
+void FJamLicenseSelectionKey::AddAsset(FName PackageName, FName AssetName)
+{
+	// Spread the two 32 bit name hashes over 64 bits (splitmix64 finalizer), then sum so that order doesn't matter
+	uint64 Item = (uint64(GetTypeHash(PackageName)) << 32) | uint64(GetTypeHash(AssetName));
+	Item ^= Item >> 30;
+	Item *= 0xbf58476d1ce4e5b9ull;
+	Item ^= Item >> 27;
+	Item *= 0x94d049bb133111ebull;
+	Item ^= Item >> 31;
+
+	Hash += Item;
+	++Num;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+struct FJamLicenseSelectionCacheEntry
+{
+	FJamLicenseSelectionKey Key;
+	TSharedRef<const FJamLicenseSelectionSummary> Summary;
+};
+
+static FCriticalSection GSelectionCacheLock;
+static TArray<FJamLicenseSelectionCacheEntry> GSelectionCacheEntries;
+static FJamLicenseCacheCounter GSelectionCacheCounter;
+
+TSharedRef<const FJamLicenseSelectionSummary> FJamLicenseSelectionCache::FindOrCompute(TArrayView<UObject* const> Objects)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	const FJamLicenseSelectionKey Key = FJamLicenseSelectionKey::FromObjects(Objects);
+
+	TSharedPtr<const FJamLicenseSelectionSummary> Existing = Find(Key);
+	GSelectionCacheCounter.Record(Existing.IsValid());
+	if (Existing.IsValid())
+	{
+		return Existing.ToSharedRef();
+	}
+
+	TSharedRef<const FJamLicenseSelectionSummary> Summary = MakeShared<FJamLicenseSelectionSummary>(FJamLicenseSelectionSummary::ComputeFromObjects(Objects));
+	Add(Key, Summary);
+	return Summary;
+}
+
+TSharedPtr<const FJamLicenseSelectionSummary> FJamLicenseSelectionCache::Find(const FJamLicenseSelectionKey& Key)
+{
+	FScopeLock Lock(&GSelectionCacheLock);
+
+	for (int32 Index = 0; Index < GSelectionCacheEntries.Num(); ++Index)
+	{
+		if (GSelectionCacheEntries[Index].Key == Key)
+		{
+			// Move it to the front so it's the last to be evicted
+			FJamLicenseSelectionCacheEntry Entry = GSelectionCacheEntries[Index];
+			GSelectionCacheEntries.RemoveAt(Index, 1, /*bAllowShrinking=*/ false);
+			GSelectionCacheEntries.Insert(Entry, 0);
+			return Entry.Summary;
+		}
+	}
+
+	return nullptr;
+}
+
+void FJamLicenseSelectionCache::Add(const FJamLicenseSelectionKey& Key, TSharedRef<const FJamLicenseSelectionSummary> Summary)
+{
+	FScopeLock Lock(&GSelectionCacheLock);
+
+	// Entries from an older index version can never be hit again
+	GSelectionCacheEntries.RemoveAll([&Key](const FJamLicenseSelectionCacheEntry& Entry) { return (Entry.Key.IndexVersion != Key.IndexVersion) || (Entry.Key == Key); });
+
+	GSelectionCacheEntries.Insert(FJamLicenseSelectionCacheEntry{ Key, Summary }, 0);
+	if (GSelectionCacheEntries.Num() > MaxEntries)
+	{
+		GSelectionCacheEntries.RemoveAt(MaxEntries, GSelectionCacheEntries.Num() - MaxEntries);
+	}
+}
+
+void FJamLicenseSelectionCache::Reset()
+{
+	FScopeLock Lock(&GSelectionCacheLock);
+	GSelectionCacheEntries.Empty();
+}
+
+const FJamLicenseCacheCounter& FJamLicenseSelectionCache::GetCounter()
+{
+	return GSelectionCacheCounter;
+}
+
+void FJamLicenseSelectionCache::GetMemoryUsage(FJamLicenseMemoryUsage& InOutUsage)
+{
+	FScopeLock Lock(&GSelectionCacheLock);
+
+	InOutUsage.Caches += GSelectionCacheEntries.GetAllocatedSize();
+	for (const FJamLicenseSelectionCacheEntry& Entry : GSelectionCacheEntries)
+	{
+		InOutUsage.Caches += sizeof(FJamLicenseSelectionSummary) + Entry.Summary->URLUsageMap.GetAllocatedSize();
+		for (const TPair<FString, int32>& Pair : Entry.Summary->URLUsageMap)
+		{
+			InOutUsage.Caches += Pair.Key.GetAllocatedSize();
+		}
+	}
+}
@@ -0,0 +1,94 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FJamLicenseCacheCounter;
+struct FJamLicenseMemoryUsage;
+
+// Summary of the asset source URLs used by a selection of assets
+struct FJamLicenseSelectionSummary
+{
+	// How many selected assets use each source URL
+	TMap<FString, int32> URLUsageMap;
+
+	// How many selected assets have no source URL at all
+	int32 NumAssetsWithNoURL = 0;
+
+	bool AnyHaveLicense() const
+	{
+		return URLUsageMap.Num() > 0;
+	}
+
+	bool AnyMissingLicense() const
+	{
+		return NumAssetsWithNoURL > 0;
+	}
+
+	// Returns the source URL if every selected asset has the same one, or an empty string otherwise
+	FString GetSharedURL() const;
+
+	// Builds a summary from the package metadata of loaded assets
+	static FJamLicenseSelectionSummary ComputeFromObjects(TArrayView<UObject* const> Objects);
+};
+
+// Identifies a selection of assets independent of selection order
+struct FJamLicenseSelectionKey
+{
+	uint64 Hash = 0;
+	int32 Num = 0;
+	uint32 IndexVersion = 0;
+
+	static FJamLicenseSelectionKey FromObjects(TArrayView<UObject* const> Objects);
+
+	bool operator==(const FJamLicenseSelectionKey& Other) const
+	{
+		return (Hash == Other.Hash) && (Num == Other.Num) && (IndexVersion == Other.IndexVersion);
+	}
+
+	// Mixes one selected asset into the key
+	void AddAsset(FName PackageName, FName AssetName);
+};
+
+// Remembers the summaries of the most recently used selections, so that re-opening the context menu
+// on the same selection doesn't have to walk all of the selected metadata again
+//
+// Entries are keyed on FJamLicenseIndex::GetVersion(), so any relevant change invalidates them
+class FJamLicenseSelectionCache
+{
+public:
+	static TSharedRef<const FJamLicenseSelectionSummary> FindOrCompute(TArrayView<UObject* const> Objects);
+
+	static TSharedPtr<const FJamLicenseSelectionSummary> Find(const FJamLicenseSelectionKey& Key);
+	static void Add(const FJamLicenseSelectionKey& Key, TSharedRef<const FJamLicenseSelectionSummary> Summary);
+
+	static void Reset();
+
+	static void GetMemoryUsage(FJamLicenseMemoryUsage& InOutUsage);
+
+	// Hits are context menus that found their selection already summarized (by an earlier menu or the prefetcher)
+	static const FJamLicenseCacheCounter& GetCounter();
+
+private:
+	// A handful is plenty, the common case is bouncing between submenus of the same selection
+	static constexpr int32 MaxEntries = 4;
+};
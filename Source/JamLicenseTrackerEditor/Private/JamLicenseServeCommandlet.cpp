@@ -0,0 +1,321 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseServeCommandlet.h"
+
+#include "JamLicenseIndex.h"
+#include "JamLicenseQueryService.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "Common/TcpListener.h"
+#include "Containers/Queue.h"
+#include "DirectoryWatcherModule.h"
+#include "IAssetRegistry.h"
+#include "IDirectoryWatcher.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+namespace JamLicenseServe
+{
+	struct FClient
+	{
+		FSocket* Socket = nullptr;
+
+		// Bytes received that don't form a complete line yet
+		TArray<uint8> PendingBytes;
+
+		// Responses that haven't been sent yet, because the client isn't reading fast enough
+		TArray<uint8> OutgoingBytes;
+
+		// When OutgoingBytes last shrank (or became non-empty)
+		double LastSendProgressTime = 0.0;
+	};
+
+	// A client that leaves responses unread for this long is dropped, so it can't hold on to memory forever
+	static constexpr double SendTimeoutSeconds = 30.0;
+
+	// New requests aren't read from a client while this much of its output is still queued
+	static constexpr int32 MaxQueuedOutputBytes = 8 * 1024 * 1024;
+
+	// Reads whatever has arrived, returning false once the connection is closed
+	static bool ReceiveFromClient(FClient& Client, TArray<FString>& OutLines)
+	{
+		uint8 Buffer[16 * 1024];
+		for (;;)
+		{
+			int32 BytesRead = 0;
+			// Stream sockets report EWOULDBLOCK as a successful read of 0 bytes, so a failed Recv means the peer closed the
+			// connection or a real error happened (GetLastErrorCode can't tell which, a graceful close doesn't set it and it
+			// may still hold the EWOULDBLOCK from an earlier poll)
+			if (!Client.Socket->Recv(Buffer, sizeof(Buffer), /*out*/ BytesRead))
+			{
+				return false;
+			}
+
+			// Nothing more has arrived yet
+			if (BytesRead == 0)
+			{
+				return Client.Socket->GetConnectionState() != SCS_ConnectionError;
+			}
+
+			int32 LineStart = 0;
+			for (int32 Index = 0; Index < BytesRead; ++Index)
+			{
+				if (Buffer[Index] == '\n')
+				{
+					Client.PendingBytes.Append(Buffer + LineStart, Index - LineStart);
+					OutLines.Add(FString(FUTF8ToTCHAR((const ANSICHAR*)Client.PendingBytes.GetData(), Client.PendingBytes.Num())));
+					Client.PendingBytes.Reset();
+					LineStart = Index + 1;
+				}
+			}
+			Client.PendingBytes.Append(Buffer + LineStart, BytesRead - LineStart);
+		}
+	}
+
+	// Queues a response line, it is sent by FlushToClient as the client's receive buffer allows
+	static void QueueForClient(FClient& Client, const FString& Line)
+	{
+		FTCHARToUTF8 Converted(*(Line + TEXT("\n")));
+		if (Client.OutgoingBytes.Num() == 0)
+		{
+			Client.LastSendProgressTime = FPlatformTime::Seconds();
+		}
+		Client.OutgoingBytes.Append((const uint8*)Converted.Get(), Converted.Length());
+	}
+
+	// Sends as much queued output as the socket takes without blocking, returning false if the connection failed
+	// or the client hasn't read anything for SendTimeoutSeconds
+	static bool FlushToClient(FClient& Client, double Now)
+	{
+		int32 TotalSent = 0;
+		while (TotalSent < Client.OutgoingBytes.Num())
+		{
+			int32 BytesSent = 0;
+			if (!Client.Socket->Send(Client.OutgoingBytes.GetData() + TotalSent, Client.OutgoingBytes.Num() - TotalSent, /*out*/ BytesSent))
+			{
+				if (ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK)
+				{
+					return false;
+				}
+				break;
+			}
+			if (BytesSent <= 0)
+			{
+				break;
+			}
+			TotalSent += BytesSent;
+		}
+
+		if (TotalSent > 0)
+		{
+			Client.OutgoingBytes.RemoveAt(0, TotalSent, /*bAllowShrinking=*/ false);
+			Client.LastSendProgressTime = Now;
+		}
+
+		return (Client.OutgoingBytes.Num() == 0) || ((Now - Client.LastSendProgressTime) < SendTimeoutSeconds);
+	}
+}
+
+UJamLicenseServeCommandlet::UJamLicenseServeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UJamLicenseServeCommandlet::Main(const FString& Params)
+{
+	using namespace JamLicenseServe;
+
+	int32 Port = 41990;
+	FParse::Value(*Params, TEXT("Port="), /*out*/ Port);
+
+	// Warm everything up front
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(/*bSynchronousSearch=*/ true);
+
+	const bool bCreatedIndex = !FJamLicenseIndex::IsAvailable();
+	if (bCreatedIndex)
+	{
+		FJamLicenseIndex::Initialize();
+	}
+	FJamLicenseIndex::Get().GetURLSortData();
+
+	FJamLicenseQueryService Service;
+
+	// Watch the content roots so edits made by other processes get picked up without a restart
+	TArray<FString> ChangedPackageFiles;
+	double LastChangeTime = 0.0;
+
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+	TArray<TPair<FString, FDelegateHandle>> WatchHandles;
+	if (DirectoryWatcher != nullptr)
+	{
+		TArray<FString> RootContentPaths;
+		FPackageName::QueryRootContentPaths(/*out*/ RootContentPaths);
+		for (const FString& RootPath : RootContentPaths)
+		{
+			const FString Directory = FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(RootPath));
+			if (!FPaths::DirectoryExists(Directory))
+			{
+				continue;
+			}
+
+			FDelegateHandle Handle;
+			DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory, IDirectoryWatcher::FDirectoryChanged::CreateLambda([&ChangedPackageFiles, &LastChangeTime](const TArray<FFileChangeData>& Changes)
+			{
+				for (const FFileChangeData& Change : Changes)
+				{
+					if (FPackageName::IsPackageFilename(Change.Filename))
+					{
+						ChangedPackageFiles.AddUnique(Change.Filename);
+						LastChangeTime = FPlatformTime::Seconds();
+					}
+				}
+			}), /*out*/ Handle);
+			WatchHandles.Emplace(Directory, Handle);
+		}
+	}
+
+	// Connections are accepted on the listener thread and handed over to the main loop
+	TQueue<FSocket*, EQueueMode::Mpsc> AcceptedSockets;
+	FTcpListener Listener(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port), FTimespan::FromMilliseconds(50), /*bInReusable=*/ false);
+
+	// The listen socket is created on the listener thread, so give it a moment to come up
+	for (int32 Attempt = 0; (Attempt < 100) && !Listener.IsActive(); ++Attempt)
+	{
+		FPlatformProcess::Sleep(0.02f);
+	}
+
+	if (!Listener.IsActive())
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Could not listen on 127.0.0.1:%d"), Port);
+		return 1;
+	}
+	Listener.OnConnectionAccepted().BindLambda([&AcceptedSockets](FSocket* Socket, const FIPv4Endpoint& Endpoint)
+	{
+		AcceptedSockets.Enqueue(Socket);
+		return true;
+	});
+
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("License query service ready on 127.0.0.1:%d after %.1f s (%d assets with a source URL)"), Port, FPlatformTime::Seconds() - StartTime, FJamLicenseIndex::Get().GetAssetURLIds().Num());
+
+	TArray<FClient> Clients;
+	TArray<FString> Lines;
+	double LastTickTime = FPlatformTime::Seconds();
+	while (!Service.IsShutdownRequested() && !IsEngineExitRequested())
+	{
+		const double Now = FPlatformTime::Seconds();
+		bool bDidWork = false;
+
+		// Rescan changed packages once they've settled, the index picks up the resulting registry events
+		if (DirectoryWatcher != nullptr)
+		{
+			DirectoryWatcher->Tick((float)(Now - LastTickTime));
+		}
+		LastTickTime = Now;
+
+		if ((ChangedPackageFiles.Num() > 0) && ((Now - LastChangeTime) > 0.5))
+		{
+			UE_LOG(LogJamLicenseTracker, Display, TEXT("Rescanning %d changed package files"), ChangedPackageFiles.Num());
+			AssetRegistry.ScanModifiedAssetFiles(ChangedPackageFiles);
+			ChangedPackageFiles.Reset();
+			Service.InvalidateClosures();
+			bDidWork = true;
+		}
+
+		FSocket* NewSocket = nullptr;
+		while (AcceptedSockets.Dequeue(/*out*/ NewSocket))
+		{
+			NewSocket->SetNonBlocking(true);
+			Clients.Add(FClient{ NewSocket });
+		}
+
+		for (int32 ClientIndex = Clients.Num() - 1; ClientIndex >= 0; --ClientIndex)
+		{
+			FClient& Client = Clients[ClientIndex];
+
+			// One client not reading its responses mustn't hold up the others, so output is queued and flushed as it can be
+			Lines.Reset();
+			bool bConnected = (Client.OutgoingBytes.Num() >= MaxQueuedOutputBytes) || ReceiveFromClient(Client, /*out*/ Lines);
+			for (const FString& Line : Lines)
+			{
+				if (!Line.TrimStartAndEnd().IsEmpty())
+				{
+					QueueForClient(Client, Service.HandleRequest(Line));
+					bDidWork = true;
+				}
+			}
+
+			const int32 NumQueuedBytes = Client.OutgoingBytes.Num();
+			bConnected = bConnected && FlushToClient(Client, FPlatformTime::Seconds());
+			bDidWork |= (Client.OutgoingBytes.Num() != NumQueuedBytes);
+
+			if (!bConnected)
+			{
+				Client.Socket->Close();
+				ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Client.Socket);
+				Clients.RemoveAtSwap(ClientIndex);
+			}
+		}
+
+		if (!bDidWork)
+		{
+			FPlatformProcess::Sleep(0.002f);
+		}
+	}
+
+	Listener.Stop();
+	for (FClient& Client : Clients)
+	{
+		Client.Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Client.Socket);
+	}
+
+	FSocket* UnservedSocket = nullptr;
+	while (AcceptedSockets.Dequeue(/*out*/ UnservedSocket))
+	{
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(UnservedSocket);
+	}
+
+	if (DirectoryWatcher != nullptr)
+	{
+		for (const TPair<FString, FDelegateHandle>& WatchHandle : WatchHandles)
+		{
+			DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchHandle.Key, WatchHandle.Value);
+		}
+	}
+
+	if (bCreatedIndex)
+	{
+		FJamLicenseIndex::Shutdown();
+	}
+
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("License query service stopped"));
+	return 0;
+}
@@ -0,0 +1,47 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "JamLicenseServeCommandlet.generated.h"
+
+// Keeps the license index warm and answers batched JSON queries (see FJamLicenseQueryService) from build scripts,
+// so they don't have to boot the editor for every question
+//
+// Usage: UnrealEditor-Cmd.exe MyProject.uproject -run=JamLicenseServe [-Port=41990]
+//
+// Listens on 127.0.0.1 only. Each request is one line of JSON and gets one line of JSON back, and a connection
+// can send any number of requests (responses are queued per connection, and a client that stops reading them is
+// disconnected after a timeout rather than stalling everyone else). Package files that change on disk are rescanned into the asset registry (and
+// from there into the index) while the service runs. Send {"queries":[{"op":"shutdown"}]} to stop it
+UCLASS()
+class UJamLicenseServeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJamLicenseServeCommandlet();
+
+	//~UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~End of UCommandlet interface
+};
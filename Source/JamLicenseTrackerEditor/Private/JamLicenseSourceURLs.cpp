@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseSourceURLs.h"
+
+#include "JamLicenseEditorActivation.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseTrackerSettings.h"
+#include "JamSourcePathRules.h"
+
+#include "Misc/Paths.h"
+#include "UObject/MetaData.h"
+#include "UObject/Package.h"
+
+FString FJamLicenseSourceURLs::FindURLForSourceFile(const FString& SourceFilename)
+{
+	const FJamSourcePathRuleSet RuleSet(GetDefault<UJamLicenseTrackerSettings>()->SourcePathRules);
+	if (RuleSet.IsEmpty())
+	{
+		return FString();
+	}
+
+	FString FullFilename = FPaths::ConvertRelativePathToFull(SourceFilename);
+	FPaths::NormalizeFilename(FullFilename);
+	return RuleSet.FindURLForSourceFile(FullFilename);
+}
+
+bool FJamLicenseSourceURLs::SetAssetSourceURL(UObject* Asset, const FString& URL, bool bKeepExistingURL)
+{
+	check(IsInGameThread());
+
+	UPackage* Package = (Asset != nullptr) ? Asset->GetOutermost() : nullptr;
+	UMetaData* Metadata = (Package != nullptr) ? Package->GetMetaData() : nullptr;
+	if (Metadata == nullptr)
+	{
+		return false;
+	}
+
+	if (bKeepExistingURL && Metadata->HasValue(Asset, MD_AssetSourceURL))
+	{
+		return false;
+	}
+
+	Metadata->SetValue(Asset, MD_AssetSourceURL, *URL);
+
+	// Unsaved edits have to be tracked from the start, the index can't see them in the registry tags later
+	if (FJamLicenseEditorActivation::EnsureActivated())
+	{
+		FJamLicenseIndex::Get().NotifyMetaDataChanged({ Asset }, URL);
+	}
+	return true;
+}
@@ -0,0 +1,170 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseStateBadges.h"
+
+#include "JamLicenseIndex.h"
+#include "JamLicenseTrackerSettings.h"
+
+#include "AssetData.h"
+#include "ContentBrowserDelegates.h"
+#include "ContentBrowserModule.h"
+#include "EditorStyleSet.h"
+#include "Modules/ModuleManager.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
+
+FDelegateHandle FJamLicenseStateBadges::GeneratorHandle;
+
+EJamLicenseState FJamLicenseStateBadgeCache::GetState() const
+{
+	if (!FJamLicenseIndex::IsAvailable())
+	{
+		return EJamLicenseState::NoSource;
+	}
+
+	// Versions start at 1, so a new cache always looks its state up once
+	const FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	const uint32 CurrentVersion = Index.GetVersion();
+	if (CurrentVersion != CachedVersion)
+	{
+		CachedVersion = CurrentVersion;
+		CachedState = Index.GetAssetState(ObjectPath);
+	}
+	return CachedState;
+}
+
+bool FJamLicenseStateBadgeCache::AreBadgesShown()
+{
+	return GetDefault<UJamLicenseTrackerSettings>()->bShowLicenseStateBadges && FJamLicenseIndex::IsAvailable();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Small dot drawn on an asset tile
+class SJamLicenseStateBadge : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SJamLicenseStateBadge) {}
+	SLATE_END_ARGS()
+
+	SJamLicenseStateBadge()
+		: Cache(NAME_None)
+	{
+	}
+
+	void Construct(const FArguments& InArgs, FName InObjectPath)
+	{
+		Cache = FJamLicenseStateBadgeCache(InObjectPath);
+
+		ChildSlot
+		[
+			SNew(SImage)
+			.Image(FEditorStyle::GetBrush("Icons.FilledCircle"))
+			.ColorAndOpacity(this, &SJamLicenseStateBadge::GetBadgeColor)
+			.Visibility(this, &SJamLicenseStateBadge::GetBadgeVisibility)
+		];
+	}
+
+	static FSlateColor GetStateColor(EJamLicenseState State)
+	{
+		switch (State)
+		{
+		case EJamLicenseState::Licensed:
+			return FLinearColor(0.1f, 0.7f, 0.1f);
+		case EJamLicenseState::SourceWithoutLicense:
+			return FLinearColor(0.9f, 0.7f, 0.0f);
+		case EJamLicenseState::NoSource:
+		default:
+			return FLinearColor(0.8f, 0.1f, 0.1f);
+		}
+	}
+
+	static FText GetStateDescription(EJamLicenseState State)
+	{
+		switch (State)
+		{
+		case EJamLicenseState::Licensed:
+			return LOCTEXT("LicenseState_Licensed", "Has a source URL with a license asset");
+		case EJamLicenseState::SourceWithoutLicense:
+			return LOCTEXT("LicenseState_SourceWithoutLicense", "Has a source URL, but no license asset exists for it");
+		case EJamLicenseState::NoSource:
+		default:
+			return LOCTEXT("LicenseState_NoSource", "Has no source URL");
+		}
+	}
+
+private:
+	FSlateColor GetBadgeColor() const
+	{
+		return GetStateColor(Cache.GetState());
+	}
+
+	EVisibility GetBadgeVisibility() const
+	{
+		return FJamLicenseStateBadgeCache::AreBadgesShown() ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+	}
+
+private:
+	FJamLicenseStateBadgeCache Cache;
+};
+
+static TSharedRef<SWidget> GenerateLicenseStateBadge(const FAssetData& AssetData)
+{
+	return SNew(SJamLicenseStateBadge, AssetData.ObjectPath);
+}
+
+static TSharedRef<SWidget> GenerateLicenseStateTooltip(const FAssetData& AssetData)
+{
+	return SNew(STextBlock)
+		.Text_Lambda([ObjectPath = AssetData.ObjectPath]()
+		{
+			return FJamLicenseIndex::IsAvailable() ? SJamLicenseStateBadge::GetStateDescription(FJamLicenseIndex::Get().GetAssetState(ObjectPath)) : FText::GetEmpty();
+		})
+		.Visibility_Lambda([]()
+		{
+			return FJamLicenseStateBadgeCache::AreBadgesShown() ? EVisibility::Visible : EVisibility::Collapsed;
+		});
+}
+
+void FJamLicenseStateBadges::Initialize()
+{
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+	GeneratorHandle = ContentBrowserModule.AddAssetViewExtraStateGenerator(FAssetViewExtraStateGenerator(
+		FOnGenerateAssetViewExtraStateIndicators::CreateStatic(&GenerateLicenseStateBadge),
+		FOnGenerateAssetViewExtraStateIndicators::CreateStatic(&GenerateLicenseStateTooltip)));
+}
+
+void FJamLicenseStateBadges::Shutdown()
+{
+	if (GeneratorHandle.IsValid())
+	{
+		if (FContentBrowserModule* ContentBrowserModule = FModuleManager::GetModulePtr<FContentBrowserModule>("ContentBrowser"))
+		{
+			ContentBrowserModule->RemoveAssetViewExtraStateGenerator(GeneratorHandle);
+		}
+		GeneratorHandle.Reset();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,58 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JamLicenseIndex.h"
+
+// What a badge works out each time its tile is painted, kept apart from the widget so the benchmark can time it without a renderer
+//
+// Attributes on the badge are evaluated for every visible tile every frame, so the state is only looked up
+// again when the index version changes (a single atomic load the rest of the time)
+class FJamLicenseStateBadgeCache
+{
+public:
+	explicit FJamLicenseStateBadgeCache(FName InObjectPath)
+		: ObjectPath(InObjectPath)
+	{
+	}
+
+	EJamLicenseState GetState() const;
+
+	// Whether badges are drawn at all (tiles made before the plugin activates pick their badge up once the index exists)
+	static bool AreBadgesShown();
+
+private:
+	FName ObjectPath;
+	mutable uint32 CachedVersion = 0;
+	mutable EJamLicenseState CachedState = EJamLicenseState::NoSource;
+};
+
+// Adds an optional license state indicator to Content Browser asset tiles
+class FJamLicenseStateBadges
+{
+public:
+	static void Initialize();
+	static void Shutdown();
+
+private:
+	static FDelegateHandle GeneratorHandle;
+};
@@ -0,0 +1,616 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseTagBackfill.h"
+
+#include "JamLicenseIndex.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseTrackerLog.h"
+#include "JamLicenseTrackerSettings.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "IAssetRegistry.h"
+#include "Interfaces/IPluginManager.h"
+#include "JamLicenseAssetManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/ArchiveProxy.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectResource.h"
+#include "UObject/PackageFileSummary.h"
+
+#include <atomic>
+
+FDelegateHandle FJamLicenseTagBackfill::FilesLoadedHandle;
+FDelegateHandle FJamLicenseTagBackfill::CookFilterHandle;
+
+namespace JamLicenseTagBackfill
+{
+	static std::atomic<bool> bInProgress(false);
+
+	// Held for a whole scan, so two scans never read and write the cache file at the same time
+	static FCriticalSection ScanLock;
+
+	// What a scan read from one package file, so later scans (in this session or the next) skip it while the file is unchanged
+	struct FCachedPackage
+	{
+		FDateTime ModificationTime;
+		int64 FileSize = 0;
+
+		// Object path and source URL of each asset in the package that has one
+		TArray<TPair<FString, FString>> AssetURLs;
+
+		friend FArchive& operator<<(FArchive& Ar, FCachedPackage& Package)
+		{
+			return Ar << Package.ModificationTime << Package.FileSize << Package.AssetURLs;
+		}
+	};
+
+	static const uint32 CacheMagic = 0x4A4C4246; // 'JLBF'
+	static const int32 CacheVersion = 1;
+
+	static FString GetCacheFilename()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("JamLicenseTracker") / TEXT("TagBackfillCache.bin");
+	}
+
+	// Keyed by package name
+	static void LoadCache(TMap<FString, FCachedPackage>& OutCache)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(/*out*/ Bytes, *GetCacheFilename(), FILEREAD_Silent))
+		{
+			return;
+		}
+
+		FMemoryReader Reader(Bytes);
+		uint32 Magic = 0;
+		int32 Version = 0;
+		Reader << Magic << Version;
+		if ((Magic == CacheMagic) && (Version == CacheVersion))
+		{
+			Reader << OutCache;
+		}
+
+		if (Reader.IsError() || (Magic != CacheMagic) || (Version != CacheVersion))
+		{
+			OutCache.Reset();
+		}
+	}
+
+	static void SaveCache(TMap<FString, FCachedPackage>& Cache)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		uint32 Magic = CacheMagic;
+		int32 Version = CacheVersion;
+		Writer << Magic << Version << Cache;
+
+		// Written next to the cache and moved over it, so an interrupted write never leaves a truncated cache
+		const FString CacheFilename = GetCacheFilename();
+		const FString TempFilename = CacheFilename + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempFilename) || !IFileManager::Get().Move(*CacheFilename, *TempFilename, /*bReplace=*/ true))
+		{
+			IFileManager::Get().Delete(*TempFilename);
+			UE_LOG(LogJamLicenseTracker, Warning, TEXT("Failed to write %s"), *CacheFilename);
+		}
+	}
+
+	// Only the project's own content (and its project plugins) can have been saved with this project's metadata, engine and
+	// engine plugin content never needs reading
+	static TArray<FString> GetProjectContentRoots()
+	{
+		TArray<FString> Roots = { TEXT("/Game/") };
+		for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPluginsWithContent())
+		{
+			if (Plugin->GetLoadedFrom() == EPluginLoadedFrom::Project)
+			{
+				Roots.Add(Plugin->GetMountedAssetPath());
+			}
+		}
+		return Roots;
+	}
+
+	// Reads FNames as indices into the package's name map, the way FLinkerLoad does
+	class FNameMapReader : public FArchiveProxy
+	{
+	public:
+		FNameMapReader(FArchive& InInnerArchive, const TArray<FName>& InNameMap)
+			: FArchiveProxy(InInnerArchive)
+			, NameMap(InNameMap)
+		{
+		}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 NameIndex = 0;
+			int32 Number = 0;
+			InnerArchive << NameIndex << Number;
+
+			if (NameMap.IsValidIndex(NameIndex))
+			{
+				Name = FName(NameMap[NameIndex], Number);
+			}
+			else
+			{
+				Name = NAME_None;
+				InnerArchive.SetError();
+			}
+			return *this;
+		}
+
+	private:
+		const TArray<FName>& NameMap;
+	};
+
+	static FAssetData WithSourceURLTag(const FAssetData& AssetData, const FString& URL)
+	{
+		FAssetDataTagMap Tags = AssetData.TagsAndValues.CopyMap();
+		Tags.Add(FName(MD_AssetSourceURL), URL);
+		return FAssetData(AssetData.PackageName, AssetData.PackagePath, AssetData.AssetName, AssetData.AssetClass, MoveTemp(Tags), AssetData.ChunkIDs, AssetData.PackageFlags);
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice BackfillCommand(
+		TEXT("JamLicense.Backfill"),
+		TEXT("Adds source URL tags to the asset registry for packages saved before the tag was collected (reads package files in the background)"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (bInProgress)
+			{
+				Ar.Logf(TEXT("A source URL tag backfill is already running"));
+			}
+			else
+			{
+				FJamLicenseTagBackfill::RunAsync();
+				Ar.Logf(TEXT("Started a source URL tag backfill"));
+			}
+		}));
+}
+
+void FJamLicenseTagBackfill::Initialize()
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddStatic(&FJamLicenseTagBackfill::RunAsync);
+	}
+	else
+	{
+		RunAsync();
+	}
+}
+
+bool FJamLicenseTagBackfill::IsEnabled()
+{
+	return GetDefault<UJamLicenseTrackerSettings>()->bBackfillMissingSourceURLTags;
+}
+
+void FJamLicenseTagBackfill::RegisterCookFilterHook()
+{
+	// The cook filter only sees the registry tags, so they have to be complete before it reads them
+	CookFilterHandle = UJamLicenseAssetManager::OnPreBuildCookFilter.AddLambda([]()
+	{
+		if (!IsEnabled())
+		{
+			return;
+		}
+
+		if (IsInGameThread())
+		{
+			Run();
+		}
+		else
+		{
+			UE_LOG(LogJamLicenseTracker, Warning, TEXT("The cook filter was first used off the game thread, skipping the source URL tag backfill (packages without tags may be cooked for platforms their license doesn't allow)"));
+		}
+	});
+}
+
+void FJamLicenseTagBackfill::UnregisterCookFilterHook()
+{
+	UJamLicenseAssetManager::OnPreBuildCookFilter.Remove(CookFilterHandle);
+	CookFilterHandle.Reset();
+}
+
+void FJamLicenseTagBackfill::Shutdown()
+{
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnFilesLoaded().Remove(FilesLoadedHandle);
+	}
+	FilesLoadedHandle.Reset();
+}
+
+bool FJamLicenseTagBackfill::ReadPackageURLs(const FString& PackageFilename, FName PackageName, TMap<FName, FString>& OutURLs, FString& OutError)
+{
+	using namespace JamLicenseTagBackfill;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*PackageFilename));
+	if (!Reader.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Could not open %s"), *PackageFilename);
+		return false;
+	}
+
+	FPackageFileSummary Summary;
+	*Reader << Summary;
+	if (Reader->IsError() || (Summary.Tag != PACKAGE_FILE_TAG))
+	{
+		OutError = FString::Printf(TEXT("%s is not a package file"), *PackageFilename);
+		return false;
+	}
+
+	// Cooked packages don't carry metadata
+	if (Summary.bUnversioned || ((Summary.GetPackageFlags() & PKG_FilterEditorOnly) != 0))
+	{
+		return true;
+	}
+
+	Reader->SetUEVer(Summary.GetFileVersionUE());
+	Reader->SetLicenseeUEVer(Summary.GetFileVersionLicenseeUE());
+	Reader->SetCustomVersions(Summary.GetCustomVersionContainer());
+
+	TArray<FName> NameMap;
+	NameMap.Reserve(Summary.NameCount);
+	Reader->Seek(Summary.NameOffset);
+	for (int32 NameIndex = 0; (NameIndex < Summary.NameCount) && !Reader->IsError(); ++NameIndex)
+	{
+		FNameEntrySerialized NameEntry(ENAME_LinkerConstructor);
+		*Reader << NameEntry;
+		NameMap.Add(FName(NameEntry));
+	}
+
+	FNameMapReader NameReader(*Reader, NameMap);
+
+	TArray<FObjectExport> Exports;
+	Exports.SetNum(Summary.ExportCount);
+	NameReader.Seek(Summary.ExportOffset);
+	for (int32 ExportIndex = 0; (ExportIndex < Exports.Num()) && !Reader->IsError(); ++ExportIndex)
+	{
+		NameReader << Exports[ExportIndex];
+	}
+
+	if (Reader->IsError())
+	{
+		OutError = FString::Printf(TEXT("Failed to read the header of %s"), *PackageFilename);
+		return false;
+	}
+
+	const FName NAME_PackageMetaData(TEXT("PackageMetaData"));
+	const FObjectExport* MetaDataExport = Exports.FindByPredicate([NAME_PackageMetaData](const FObjectExport& Export)
+	{
+		return (Export.ObjectName == NAME_PackageMetaData) && Export.OuterIndex.IsNull();
+	});
+	if (MetaDataExport == nullptr)
+	{
+		return true;
+	}
+
+	const int64 MetaDataEnd = MetaDataExport->SerialOffset + MetaDataExport->SerialSize;
+	NameReader.Seek(MetaDataExport->SerialOffset);
+
+	// UObject::Serialize writes the tagged properties (UMetaData has none, so just the terminating None) and an optional lazy pointer guid
+	FName PropertyName;
+	NameReader << PropertyName;
+	if (PropertyName != NAME_None)
+	{
+		OutError = FString::Printf(TEXT("Unexpected property %s in the metadata of %s"), *PropertyName.ToString(), *PackageFilename);
+		return false;
+	}
+
+	bool bHasGuid = false;
+	NameReader << bHasGuid;
+	if (bHasGuid)
+	{
+		FGuid Guid;
+		NameReader << Guid;
+	}
+
+	// Followed by UMetaData::ObjectMetaDataMap, a map of object references (package indices) to key/value pairs
+	const FName NAME_AssetSourceURL(MD_AssetSourceURL);
+	const FString PackageNameString = PackageName.ToString();
+
+	int32 NumObjects = 0;
+	NameReader << NumObjects;
+	if ((NumObjects < 0) || (NumObjects > MetaDataExport->SerialSize))
+	{
+		Reader->SetError();
+	}
+
+	for (int32 ObjectIndex = 0; (ObjectIndex < NumObjects) && !Reader->IsError(); ++ObjectIndex)
+	{
+		FPackageIndex Object;
+		int32 NumValues = 0;
+		NameReader << Object << NumValues;
+		if ((NumValues < 0) || (NumValues > MetaDataExport->SerialSize))
+		{
+			Reader->SetError();
+			break;
+		}
+
+		for (int32 ValueIndex = 0; (ValueIndex < NumValues) && !Reader->IsError(); ++ValueIndex)
+		{
+			FName Key;
+			FString Value;
+			NameReader << Key << Value;
+
+			// Only top level exports can be assets
+			if ((Key == NAME_AssetSourceURL) && !Value.IsEmpty() && Object.IsExport() && Exports.IsValidIndex(Object.ToExport()))
+			{
+				const FObjectExport& Export = Exports[Object.ToExport()];
+				if (Export.OuterIndex.IsNull())
+				{
+					OutURLs.Add(FName(*FString::Printf(TEXT("%s.%s"), *PackageNameString, *Export.ObjectName.ToString())), MoveTemp(Value));
+				}
+			}
+		}
+	}
+
+	if (Reader->IsError() || (NameReader.Tell() > MetaDataEnd))
+	{
+		OutURLs.Reset();
+		OutError = FString::Printf(TEXT("Failed to read the metadata of %s"), *PackageFilename);
+		return false;
+	}
+
+	return true;
+}
+
+FJamLicenseTagBackfillResult FJamLicenseTagBackfill::Scan()
+{
+	using namespace JamLicenseTagBackfill;
+
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	FScopeLock Lock(&ScanLock);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FName NAME_AssetSourceURL(MD_AssetSourceURL);
+	const TArray<FString> ContentRoots = GetProjectContentRoots();
+
+	TArray<FAssetData> AllAssets;
+	IAssetRegistry::GetChecked().GetAllAssets(/*out*/ AllAssets, /*bIncludeOnlyOnDiskAssets=*/ true);
+
+	// A package with any tagged asset was saved with the rule in place, so the registry already has everything in it
+	TMap<FName, TArray<int32>> CandidatePackages;
+	TSet<FName> TaggedPackages;
+	for (int32 AssetIndex = 0; AssetIndex < AllAssets.Num(); ++AssetIndex)
+	{
+		const FAssetData& AssetData = AllAssets[AssetIndex];
+		if (AssetData.FindTag(NAME_AssetSourceURL))
+		{
+			TaggedPackages.Add(AssetData.PackageName);
+		}
+		else if (TArray<int32>* pAssetIndices = CandidatePackages.Find(AssetData.PackageName))
+		{
+			pAssetIndices->Add(AssetIndex);
+		}
+		else
+		{
+			const FString PackageNameString = AssetData.PackageName.ToString();
+			if (ContentRoots.ContainsByPredicate([&PackageNameString](const FString& Root) { return PackageNameString.StartsWith(Root); }))
+			{
+				CandidatePackages.Add(AssetData.PackageName).Add(AssetIndex);
+			}
+		}
+	}
+
+	for (FName PackageName : TaggedPackages)
+	{
+		CandidatePackages.Remove(PackageName);
+	}
+
+	TArray<FName> PackageNames;
+	CandidatePackages.GenerateKeyArray(/*out*/ PackageNames);
+
+	TMap<FString, FCachedPackage> Cache;
+	LoadCache(/*out*/ Cache);
+
+	// Only read during the parallel part, every package's up to date entry goes into UpdatedCache afterwards
+	TArray<TMap<FName, FString>> PackageURLs;
+	PackageURLs.SetNum(PackageNames.Num());
+	TArray<TOptional<FCachedPackage>> PackageCacheEntries;
+	PackageCacheEntries.SetNum(PackageNames.Num());
+	std::atomic<int32> NumFailed(0);
+	std::atomic<int32> NumCached(0);
+
+	ParallelFor(PackageNames.Num(), [&PackageNames, &PackageURLs, &PackageCacheEntries, &Cache, &NumFailed, &NumCached](int32 PackageIndex)
+	{
+		LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+		const FString PackageNameString = PackageNames[PackageIndex].ToString();
+		FString PackageFilename;
+		if (!FPackageName::DoesPackageExist(PackageNameString, /*out*/ &PackageFilename))
+		{
+			return;
+		}
+
+		const FFileStatData StatData = IFileManager::Get().GetStatData(*PackageFilename);
+		const FCachedPackage* CachedPackage = Cache.Find(PackageNameString);
+		if (StatData.bIsValid && (CachedPackage != nullptr) && (CachedPackage->ModificationTime == StatData.ModificationTime) && (CachedPackage->FileSize == StatData.FileSize))
+		{
+			for (const TPair<FString, FString>& AssetURL : CachedPackage->AssetURLs)
+			{
+				PackageURLs[PackageIndex].Add(FName(*AssetURL.Key), AssetURL.Value);
+			}
+			PackageCacheEntries[PackageIndex] = *CachedPackage;
+			NumCached.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		FString Error;
+		if (!ReadPackageURLs(PackageFilename, PackageNames[PackageIndex], /*out*/ PackageURLs[PackageIndex], /*out*/ Error))
+		{
+			// Not cached, so it is tried again next time
+			UE_LOG(LogJamLicenseTracker, Verbose, TEXT("%s"), *Error);
+			NumFailed.fetch_add(1, std::memory_order_relaxed);
+		}
+		else if (StatData.bIsValid)
+		{
+			FCachedPackage Entry;
+			Entry.ModificationTime = StatData.ModificationTime;
+			Entry.FileSize = StatData.FileSize;
+			for (const TPair<FName, FString>& AssetURL : PackageURLs[PackageIndex])
+			{
+				Entry.AssetURLs.Emplace(AssetURL.Key.ToString(), AssetURL.Value);
+			}
+			PackageCacheEntries[PackageIndex] = MoveTemp(Entry);
+		}
+	});
+
+	// Packages that were deleted, or have been resaved with their tags since, drop out of the cache
+	TMap<FString, FCachedPackage> UpdatedCache;
+	UpdatedCache.Reserve(PackageNames.Num());
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		if (PackageCacheEntries[PackageIndex].IsSet())
+		{
+			UpdatedCache.Add(PackageNames[PackageIndex].ToString(), MoveTemp(PackageCacheEntries[PackageIndex].GetValue()));
+		}
+	}
+
+	if ((NumCached != PackageNames.Num()) || (UpdatedCache.Num() != Cache.Num()))
+	{
+		SaveCache(UpdatedCache);
+	}
+
+	FJamLicenseTagBackfillResult Result;
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		if (PackageURLs[PackageIndex].Num() > 0)
+		{
+			for (int32 AssetIndex : CandidatePackages.FindChecked(PackageNames[PackageIndex]))
+			{
+				const FAssetData& AssetData = AllAssets[AssetIndex];
+				if (const FString* URL = PackageURLs[PackageIndex].Find(AssetData.ObjectPath))
+				{
+					Result.TaggedAssets.Add(WithSourceURLTag(AssetData, *URL));
+				}
+			}
+		}
+	}
+
+	Result.NumPackagesScanned = PackageNames.Num();
+	Result.NumPackagesCached = NumCached;
+	Result.NumPackagesFailed = NumFailed;
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	return Result;
+}
+
+int32 FJamLicenseTagBackfill::Inject(const TArray<FAssetData>& TaggedAssets)
+{
+	check(IsInGameThread());
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (AssetRegistry == nullptr)
+	{
+		return 0;
+	}
+
+	FJamLicenseIndex* Index = FJamLicenseIndex::IsAvailable() ? &FJamLicenseIndex::Get() : nullptr;
+	const FName NAME_AssetSourceURL(MD_AssetSourceURL);
+
+	FAssetRegistryState State;
+	int32 NumInjected = 0;
+	for (const FAssetData& TaggedAsset : TaggedAssets)
+	{
+		// Skip anything that was deleted, renamed, or resaved since the scan, or that has a newer unsaved edit
+		const FAssetData Current = AssetRegistry->GetAssetByObjectPath(TaggedAsset.ObjectPath);
+		if (!Current.IsValid() || Current.FindTag(NAME_AssetSourceURL) || ((Index != nullptr) && Index->HasUnsavedMetaDataEdits(TaggedAsset.PackageName)))
+		{
+			continue;
+		}
+
+		State.AddAssetData(new FAssetData(TaggedAsset));
+		++NumInjected;
+	}
+
+	if (NumInjected > 0)
+	{
+		// AppendState replaces the tags of assets it already knows about, but reports them as added
+		if (Index != nullptr)
+		{
+			Index->SetReaddingExistingAssets(true);
+		}
+
+		AssetRegistry->AppendState(State);
+
+		if (Index != nullptr)
+		{
+			Index->SetReaddingExistingAssets(false);
+		}
+	}
+
+	return NumInjected;
+}
+
+int32 FJamLicenseTagBackfill::Run()
+{
+	const FJamLicenseTagBackfillResult Result = Scan();
+	const int32 NumInjected = Inject(Result.TaggedAssets);
+	LogResult(Result, NumInjected);
+	return NumInjected;
+}
+
+void FJamLicenseTagBackfill::RunAsync()
+{
+	using namespace JamLicenseTagBackfill;
+
+	if (bInProgress.exchange(true))
+	{
+		return;
+	}
+
+	Async(EAsyncExecution::Thread, []()
+	{
+		FJamLicenseTagBackfillResult Result = Scan();
+
+		AsyncTask(ENamedThreads::GameThread, [Result = MoveTemp(Result)]()
+		{
+			const int32 NumInjected = Inject(Result.TaggedAssets);
+			LogResult(Result, NumInjected);
+			bInProgress = false;
+		});
+	});
+}
+
+void FJamLicenseTagBackfill::LogResult(const FJamLicenseTagBackfillResult& Result, int32 NumInjected)
+{
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("Source URL tag backfill checked %d packages (%d unchanged since they were last read) in %.2f s and added tags for %d assets (%d packages could not be read)"),
+		Result.NumPackagesScanned, Result.NumPackagesCached, Result.Seconds, NumInjected, Result.NumPackagesFailed);
+
+	if (NumInjected > 0)
+	{
+		UE_LOG(LogJamLicenseTracker, Display, TEXT("Resave those packages to store the tags permanently (e.g., with the ResavePackages commandlet)"));
+	}
+}
@@ -0,0 +1,84 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+// Outcome of scanning package files for source URLs the asset registry doesn't have
+struct FJamLicenseTagBackfillResult
+{
+	// Copies of the registry's asset data with the source URL tag added
+	TArray<FAssetData> TaggedAssets;
+
+	int32 NumPackagesScanned = 0;
+
+	// Packages whose file hadn't changed since a previous scan read it, so the cached result was used
+	int32 NumPackagesCached = 0;
+
+	int32 NumPackagesFailed = 0;
+	double Seconds = 0.0;
+};
+
+// Adds source URL tags to the asset registry for packages saved before MD_AssetSourceURL was in MetaDataTagsForAssetRegistry
+//
+// Those packages have the URL in their UMetaData but not in the tags the registry gathered from them, so they are invisible to
+// GetAssetsByTags until resaved. The backfill reads just the package summary, name map, export map and metadata export of each
+// package without any tagged assets (in parallel, without loading anything), then adds the missing tags to the registry's in-memory
+// state. Only packages under /Game and the project's own plugins are read, and what was read from each package file is cached in
+// Saved/JamLicenseTracker by file timestamp and size, so later sessions only read packages that changed until they are resaved.
+//
+// The cook filter (UJamLicenseAssetManager) and JamLicenseVerifyContainers run the backfill before they read the registry tags.
+class FJamLicenseTagBackfill
+{
+public:
+	// Runs the backfill once the initial asset registry scan is done (if enabled in the settings)
+	static void Initialize();
+	static void Shutdown();
+
+	// Runs the backfill before the cook filter is first built (if enabled in the settings), including in cook commandlets
+	static void RegisterCookFilterHook();
+	static void UnregisterCookFilterHook();
+
+	// Returns true if Backfill Missing Source URL Tags is on in the plugin settings
+	static bool IsEnabled();
+
+	// Reads the source URLs from a package file's metadata, keyed by asset object path (safe to call from any thread)
+	static bool ReadPackageURLs(const FString& PackageFilename, FName PackageName, TMap<FName, FString>& OutURLs, FString& OutError);
+
+	// Reads every on-disk package that has no tagged assets (blocking, safe to call from any thread)
+	static FJamLicenseTagBackfillResult Scan();
+
+	// Adds the tags to the asset registry (and the license index), returning how many assets were updated (game thread only)
+	static int32 Inject(const TArray<FAssetData>& TaggedAssets);
+
+	// Scans and injects on the calling thread, for commandlets
+	static int32 Run();
+
+	// Scans on a background thread, then injects on the game thread
+	static void RunAsync();
+
+private:
+	static void LogResult(const FJamLicenseTagBackfillResult& Result, int32 NumInjected);
+
+	static FDelegateHandle FilesLoadedHandle;
+	static FDelegateHandle CookFilterHandle;
+};
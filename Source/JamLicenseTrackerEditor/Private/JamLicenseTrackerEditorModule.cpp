@@ -23,6 +23,21 @@
 #include "ToolMenus.h"
 
 #include "JamAssetLicense.h"
+#include "JamAssetLicenseDetails.h"
+#include "JamLicenseAssociatedAssets.h"
+#include "JamLicenseBudget.h"
+#include "JamLicenseCollections.h"
+#include "JamLicenseEditorActivation.h"
+#include "JamLicenseEditorDiagnostics.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseSelectionSummary.h"
+#include "JamLicenseStateBadges.h"
+#include "JamLicenseTagBackfill.h"
+#include "JamLicenseTrackerSettings.h"
+#include "JamSourcePathRules.h"
+#include "SJamLicenseBrowser.h"
+#include "SJamLicenseCoverageTree.h"
 
 #include "Engine/AssetManagerSettings.h"
 #include "Modules/ModuleManager.h"
@@ -33,6 +48,7 @@
 #include "Framework/Notifications/NotificationManager.h"
 #include "SSettingsEditorCheckoutNotice.h"
 #include "Logging/MessageLog.h"
+#include "MessageLogModule.h"
 
 #include "IAssetRegistry.h"
 #include "ContentBrowserModule.h"
@@ -42,21 +58,8 @@
 //@TODO: The asset source association is not preserved when an asset is duplicated
 // (duplicating an asset doesn't copy metadata and there's currently no engine level delegate for asset or object duplication)
 
-//@TODO: Implement the runtime enumeration of licenses that survived cooking
-//  Options:
-//    - Create an (editor-only) dependency from every asset to the associated license asset that
-//      shares the same source URL, causing it to get cooked automatically
-//    - Modify the cook rule for each individual primary asset in the asset manager to only cook
-//      if any related asset is getting cooked (TBD on if we can ask that question at the time we need to)
-//    - Create a single manifest asset that harvests the other licenses for things being cooked
-//      (same problem as above, unsure if we have access to a cook manifest when we need it)
-//  Interim/workaround:
-//    - Make a manually triggered 'harvest' command that is fed an Audit_InCook style collection
-
 #define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
 
-static const TCHAR* MD_AssetSourceURL = TEXT("AssetSourceURL");
-
 class FJamLicenseTrackerEditorModule : public IModuleInterface
 {
 public:
@@ -65,75 +68,110 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override
 	{
+		// Cooks usually run as commandlets, so this is registered even without the editor UI
+		FJamLicenseTagBackfill::RegisterCookFilterHook();
+
 		if (!IsRunningGame() && FSlateApplication::IsInitialized())
 		{
+			LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+			FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+			MessageLogModule.RegisterLogListing("JamLicenseTracker", LOCTEXT("JamLicenseTrackerLogLabel", "License Tracker"));
+
+			// Only stubs are registered here, anything expensive waits for FJamLicenseEditorActivation
+			FJamLicenseStateBadges::Initialize();
+			SJamLicenseBrowser::RegisterTabSpawner();
+			SJamLicenseCoverageTree::RegisterTabSpawner();
+			FJamAssetLicenseDetails::Register();
+
+			MemoryReportHandle = FJamLicenseMemoryReport::OnGather().AddStatic(&GatherMemoryUsage);
+			FJamLicenseEditorDiagnostics::Initialize();
+
 			UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateStatic(&AddAssetMenuOptions));
 
-			// Register to get a warning on startup if settings aren't configured correctly
-			UAssetManager::CallOrRegister_OnAssetManagerCreated(FSimpleMulticastDelegate::FDelegate::CreateStatic(&OnAssetManagerCreated));
+			// Register to get a warning once activated if settings aren't configured correctly
+			FJamLicenseEditorActivation::OnActivated().AddLambda([]()
+			{
+				UAssetManager::CallOrRegister_OnAssetManagerCreated(FSimpleMulticastDelegate::FDelegate::CreateStatic(&OnAssetManagerCreated));
+			});
+
+			FJamLicenseEditorActivation::Initialize();
 		}
 	}
 
 	virtual void ShutdownModule() override
 	{
+		FJamLicenseTagBackfill::UnregisterCookFilterHook();
+		FJamLicenseEditorDiagnostics::Shutdown();
+		FJamLicenseMemoryReport::OnGather().Remove(MemoryReportHandle);
+		FJamAssetLicenseDetails::Unregister();
+		SJamLicenseCoverageTree::UnregisterTabSpawner();
+		SJamLicenseBrowser::UnregisterTabSpawner();
+		FJamLicenseStateBadges::Shutdown();
+		FJamLicenseEditorActivation::Shutdown();
+		FJamLicenseSelectionCache::Reset();
+
+		if (FMessageLogModule* MessageLogModule = FModuleManager::GetModulePtr<FMessageLogModule>("MessageLog"))
+		{
+			MessageLogModule->UnregisterLogListing("JamLicenseTracker");
+		}
 	}
 
 private:
+	static void GatherMemoryUsage(FJamLicenseMemoryReport& Report)
+	{
+		if (FJamLicenseIndex::IsAvailable())
+		{
+			FJamLicenseMemoryUsage IndexUsage;
+			FJamLicenseIndex::Get().GetMemoryUsage(/*inout*/ IndexUsage);
+			Report.Add(TEXT("Index"), IndexUsage);
+		}
+
+		FJamLicenseMemoryUsage SelectionCacheUsage;
+		FJamLicenseSelectionCache::GetMemoryUsage(/*inout*/ SelectionCacheUsage);
+		Report.Add(TEXT("SelectionCache"), SelectionCacheUsage);
+	}
+
+	// Stands in for the license entries of a menu while the index is still being built
+	static void AddBuildingIndexEntry(FToolMenuSection& InSection)
+	{
+		InSection.AddMenuEntry(
+			FName("JamLicenseBuildingIndex"),
+			FJamLicenseEditorActivation::GetBuildingText(),
+			LOCTEXT("BuildingLicenseIndex_Tooltip", "License information will be available once the license index has been built"),
+			TAttribute<FSlateIcon>(),
+			FToolUIActionChoice(FUIAction(FExecuteAction(), FCanExecuteAction::CreateLambda([]() { return false; }))),
+			EUserInterfaceActionType::Button);
+	}
+
 	// Adds the options to all assets
 	static void AddAssetSourceOptions(FToolMenuSection& InSection)
 	{
+		FJamLicenseBudgetScope BudgetScope(TEXT("AddAssetSourceOptions"));
+		if (!FJamLicenseEditorActivation::RequestActivation())
+		{
+			AddBuildingIndexEntry(InSection);
+			return;
+		}
 		const TAttribute<FSlateIcon> NoIcon;
 
 		UContentBrowserAssetContextMenuContext* Context = InSection.FindContext<UContentBrowserAssetContextMenuContext>();
 		check(Context);
 		TArray<UObject*> SelectedObjects = Context->GetSelectedObjects();
 
-		bool bAnyHaveLicense = false;
-		bool bAnyMissingLicense = false;
-		FString SharedLicenseAssetID;
-
 		// See if any selected asset have a license and if all of them share the same license
-		for (UObject* Obj : SelectedObjects)
-		{
-			if (UPackage* Package = Obj->GetOutermost())
-			{
-				if (UMetaData* Metadata = Package->HasMetaData() ? Package->GetMetaData() : nullptr)
-				{
-					const FString& LicenseAssetID = Metadata->GetValue(Obj, MD_AssetSourceURL);
-
-					if (LicenseAssetID.IsEmpty())
-					{
-						bAnyMissingLicense = true;
-						SharedLicenseAssetID = FString();
-					}
-					else
-					{
-						if (!bAnyHaveLicense && !bAnyMissingLicense)
-						{
-							SharedLicenseAssetID = LicenseAssetID;
-						}
-						else
-						{
-							if (LicenseAssetID != SharedLicenseAssetID)
-							{
-								SharedLicenseAssetID = FString();
-							}
-						}
-						bAnyHaveLicense = true;
-					}
-				}
-				else
-				{
-					bAnyMissingLicense = true;
-				}
-			}
-		}
+		TSharedRef<const FJamLicenseSelectionSummary> Summary = FJamLicenseSelectionCache::FindOrCompute(SelectedObjects);
+		BudgetScope.AddContext(TEXT("Selection"), SelectedObjects.Num());
+		BudgetScope.AddContext(TEXT("URLs"), Summary->URLUsageMap.Num());
+		const bool bAnyHaveLicense = Summary->AnyHaveLicense();
+		const FString SharedLicenseAssetID = Summary->GetSharedURL();
 
 		if (!SharedLicenseAssetID.IsEmpty())
 		{
 			// All assets have a license set, and it's the same one, so skip the submenu and provide a direct open action
 			FToolUIActionChoice OpenLicenseURLAction(FExecuteAction::CreateLambda([WeakObjects = Context->SelectedObjects, SharedLicenseAssetID]()
 			{
+				FJamLicenseBudgetScope BudgetScope(TEXT("ViewSource"));
 				FPlatformProcess::LaunchURL(*SharedLicenseAssetID, nullptr, nullptr);
 			}));
 
@@ -170,7 +208,11 @@ private:
 
 				if ((TextCommitType != ETextCommit::OnCleared) && (EndingValue != StartingValue))
 				{
+					FJamLicenseBudgetScope BudgetScope(TEXT("SetSourceURL"));
+					BudgetScope.AddContext(TEXT("Selection"), WeakObjects.Num());
+
 					const FScopedTransaction Transaction(LOCTEXT("SetAssetSourceTransaction", "Set Asset Source URL"));
+					TArray<UObject*> ModifiedAssets;
 
 					for (TWeakObjectPtr<UObject> WeakPtr : WeakObjects)
 					{
@@ -179,6 +221,7 @@ private:
 							if (UPackage* Package = Asset->GetOutermost())
 							{
 								Package->Modify();
+								ModifiedAssets.Add(Asset);
 								if (UMetaData* Metadata = Package->GetMetaData())
 								{
 									if (EndingValue.IsEmpty())
@@ -193,6 +236,8 @@ private:
 							}
 						}
 					}
+
+					FJamLicenseIndex::Get().NotifyMetaDataChanged(ModifiedAssets, EndingValue);
 				}
 			};
 
@@ -209,6 +254,11 @@ private:
 	// Adds the UJamAssetLicense specific options
 	static void AddJamAssetLicenseOptions(FToolMenuSection& InSection)
 	{
+		FJamLicenseBudgetScope BudgetScope(TEXT("AddJamAssetLicenseOptions"));
+
+		// Nothing here needs the index yet (finding associated assets falls back to a registry query while it's being built)
+		FJamLicenseEditorActivation::RequestActivation();
+
 		UContentBrowserAssetContextMenuContext* Context = InSection.FindContext<UContentBrowserAssetContextMenuContext>();
 		check(Context);
 		
@@ -216,6 +266,8 @@ private:
 		{
 			FToolUIActionChoice SelectRelatedAssetsAction(FExecuteAction::CreateLambda([WeakObjects = Context->SelectedObjects]()
 			{
+				FJamLicenseBudgetScope BudgetScope(TEXT("SelectAssociatedAssets"));
+
 				TSet<FString> AssetSourceURLs;
 				for (TWeakObjectPtr<UObject> WeakPtr : WeakObjects)
 				{
@@ -228,27 +280,23 @@ private:
 					}
 				}
 
-				IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
-				const FName NAME_AssetSourceURL(MD_AssetSourceURL);
-
-				TArray<FAssetData> PotentialAssetList;
-				AssetRegistry.GetAssetsByTags({ NAME_AssetSourceURL }, /*out*/  PotentialAssetList);
-
 				TArray<FAssetData> MatchingAssetList;
-				MatchingAssetList.Reserve(PotentialAssetList.Num());
-				for (const FAssetData& AssetData : PotentialAssetList)
+				FJamLicenseAssociatedAssets::FindMatching(AssetSourceURLs, /*out*/ MatchingAssetList);
+				BudgetScope.AddContext(TEXT("URLs"), AssetSourceURLs.Num());
+				BudgetScope.AddContext(TEXT("Matches"), MatchingAssetList.Num());
+
+				if (MatchingAssetList.Num() > GetDefault<UJamLicenseTrackerSettings>()->MaxAssociatedAssetsToSyncDirectly)
 				{
-					FString TestURL;
-					if (AssetData.GetTagValue(NAME_AssetSourceURL, /*out*/ TestURL))
+					TArray<FName> MatchingObjectPaths;
+					MatchingObjectPaths.Reserve(MatchingAssetList.Num());
+					for (const FAssetData& AssetData : MatchingAssetList)
 					{
-						if (AssetSourceURLs.Contains(TestURL))
-						{
-							MatchingAssetList.Add(AssetData);
-						}
+						MatchingObjectPaths.Add(AssetData.ObjectPath);
 					}
-				}
 
-				if (MatchingAssetList.Num() > 0)
+					FJamLicenseCollections::ShowInAssociatedAssetsCollection(MatchingObjectPaths);
+				}
+				else if (MatchingAssetList.Num() > 0)
 				{
 					FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
 					ContentBrowserModule.Get().SyncBrowserToAssets(MatchingAssetList, /*bAllowLockedBrowsers=*/ false, /*bFocusContentBrowser=*/ true);
@@ -268,6 +316,8 @@ private:
 		{
 			FToolUIActionChoice ViewAssetSourceAction(FExecuteAction::CreateLambda([WeakObjects = Context->SelectedObjects]()
 			{
+				FJamLicenseBudgetScope BudgetScope(TEXT("OpenAssetSourceURL"));
+
 				TSet<FString> AssetSourceURLs;
 				for (TWeakObjectPtr<UObject> WeakPtr : WeakObjects)
 				{
@@ -280,6 +330,7 @@ private:
 					}
 				}
 
+				BudgetScope.AddContext(TEXT("URLs"), AssetSourceURLs.Num());
 				for (const FString& URL : AssetSourceURLs)
 				{
 					FPlatformProcess::LaunchURL(*URL, nullptr, nullptr);
@@ -296,6 +347,80 @@ private:
 		}
 	}
 
+	// Shows the coverage rollup for the selected folders, and the source path rule actions
+	static void AddFolderCoverageOptions(FToolMenuSection& InSection)
+	{
+		UContentBrowserFolderContext* Context = InSection.FindContext<UContentBrowserFolderContext>();
+		if (Context == nullptr)
+		{
+			return;
+		}
+
+		FJamLicenseBudgetScope BudgetScope(TEXT("AddFolderCoverageOptions"));
+		BudgetScope.AddContext(TEXT("Folders"), Context->SelectedPackagePaths.Num());
+
+		if (FJamLicenseEditorActivation::RequestActivation())
+		{
+			// Keep the menu a sensible size for big multi-folder selections
+			const int32 MaxFoldersToShow = 8;
+			for (int32 PathIndex = 0; PathIndex < FMath::Min(Context->SelectedPackagePaths.Num(), MaxFoldersToShow); ++PathIndex)
+			{
+				const FString& FolderPath = Context->SelectedPackagePaths[PathIndex];
+				InSection.AddEntry(FToolMenuEntry::InitWidget(
+					FName(*FString::Printf(TEXT("LicenseCoverage_%d"), PathIndex)),
+					SNew(SJamLicenseFolderCoverageBar, FName(*FolderPath)),
+					FText::FromString(FPaths::GetCleanFilename(FolderPath))));
+			}
+		}
+		else
+		{
+			AddBuildingIndexEntry(InSection);
+		}
+
+		// Source path rules
+		{
+			TArray<FString> FolderPaths = Context->SelectedPackagePaths;
+
+			InSection.AddMenuEntry(
+				FName("JamLicenseAction_PreviewSourcePathRules"),
+				LOCTEXT("PreviewSourcePathRules_Label", "Preview Source URL Rules"),
+				LOCTEXT("PreviewSourcePathRules_Tooltip", "Lists the source URLs the source path rules in the plugin settings would assign to assets in these folders, based on the files they were imported from"),
+				TAttribute<FSlateIcon>(),
+				FToolUIActionChoice(FExecuteAction::CreateLambda([FolderPaths]()
+				{
+					FJamLicenseBudgetScope BudgetScope(TEXT("PreviewSourcePathRules"));
+					BudgetScope.AddContext(TEXT("Folders"), FolderPaths.Num());
+					FJamSourcePathRules::Preview(FolderPaths);
+				})),
+				EUserInterfaceActionType::Button);
+
+			InSection.AddMenuEntry(
+				FName("JamLicenseAction_ApplySourcePathRules"),
+				LOCTEXT("ApplySourcePathRules_Label", "Apply Source URL Rules"),
+				LOCTEXT("ApplySourcePathRules_Tooltip", "Assigns source URLs to assets in these folders using the source path rules in the plugin settings (the affected assets will be loaded and need to be saved)"),
+				TAttribute<FSlateIcon>(),
+				FToolUIActionChoice(FExecuteAction::CreateLambda([FolderPaths]()
+				{
+					FJamLicenseBudgetScope BudgetScope(TEXT("ApplySourcePathRules"));
+					BudgetScope.AddContext(TEXT("Folders"), FolderPaths.Num());
+					FJamSourcePathRules::Apply(FolderPaths);
+				})),
+				EUserInterfaceActionType::Button);
+		}
+
+		InSection.AddMenuEntry(
+			FName("JamLicenseAction_OpenCoverage"),
+			LOCTEXT("OpenLicenseCoverage_Label", "Open License Coverage"),
+			LOCTEXT("OpenLicenseCoverage_Tooltip", "Shows license coverage for every content folder"),
+			TAttribute<FSlateIcon>(),
+			FToolUIActionChoice(FExecuteAction::CreateLambda([]()
+			{
+				FJamLicenseBudgetScope BudgetScope(TEXT("OpenLicenseCoverage"));
+				FGlobalTabmanager::Get()->TryInvokeTab(SJamLicenseCoverageTree::TabName);
+			})),
+			EUserInterfaceActionType::Button);
+	}
+
 	static void AddAssetMenuOptions()
 	{
 		{
@@ -311,40 +436,35 @@ private:
 
 			AssetActionsSection.AddDynamicEntry("JamAssetLicenseActions", FNewToolMenuSectionDelegate::CreateStatic(&AddJamAssetLicenseOptions));
 		}
+
+		{
+			UToolMenu* FolderContextMenu = UToolMenus::Get()->ExtendMenu("ContentBrowser.FolderContextMenu");
+			FToolMenuSection& CoverageSection = FolderContextMenu->AddSection("LicenseCoverageSection", LOCTEXT("LicenseCoverageMenuHeading", "License Coverage"));
+
+			CoverageSection.AddDynamicEntry("LicenseCoverage", FNewToolMenuSectionDelegate::CreateStatic(&AddFolderCoverageOptions));
+		}
 	}
 
 	static void CreateLicenseListSubmenu(UToolMenu* InMenu)
 	{
+		FJamLicenseBudgetScope BudgetScope(TEXT("CreateLicenseListSubmenu"));
 		FToolMenuSection& LicenseSection = InMenu->AddSection("LicensesSection", LOCTEXT("ViewLicenseSectionMenuHeading", "Sources"));
+		if (!FJamLicenseEditorActivation::RequestActivation())
+		{
+			AddBuildingIndexEntry(LicenseSection);
+			return;
+		}
 		
-		// Collect license URLs
-		TMap<FString, int32> URLUsageMap;
-		int32 NumAssetsWithNoURL = 0;
+		// Collect license URLs (usually already cached from building the parent menu)
+		TSharedRef<const FJamLicenseSelectionSummary> Summary = MakeShared<FJamLicenseSelectionSummary>();
 		if (UContentBrowserAssetContextMenuContext* Context = InMenu->FindContext<UContentBrowserAssetContextMenuContext>())
 		{
-			for (UObject* Asset : Context->GetSelectedObjects())
-			{
-				if (UPackage* Package = Asset->GetOutermost())
-				{
-					if (UMetaData* Metadata = Package->HasMetaData() ? Package->GetMetaData() : nullptr)
-					{
-						const FString& LicenseAssetID = Metadata->GetValue(Asset, MD_AssetSourceURL);
-						if (!LicenseAssetID.IsEmpty())
-						{
-							URLUsageMap.FindOrAdd(LicenseAssetID) += 1;
-						}
-						else
-						{
-							++NumAssetsWithNoURL;
-						}
-					}
-					else
-					{
-						++NumAssetsWithNoURL;
-					}
-				}
-			}
+			Summary = FJamLicenseSelectionCache::FindOrCompute(Context->GetSelectedObjects());
+			BudgetScope.AddContext(TEXT("Selection"), Context->SelectedObjects.Num());
 		}
+		const TMap<FString, int32>& URLUsageMap = Summary->URLUsageMap;
+		const int32 NumAssetsWithNoURL = Summary->NumAssetsWithNoURL;
+		BudgetScope.AddContext(TEXT("URLs"), URLUsageMap.Num());
 
 		// Sort the URLs by usage
 		TArray<FString> UniqueURLs;
@@ -369,6 +489,7 @@ private:
 		{
 			FToolUIActionChoice OpenLicenseURLAction(FExecuteAction::CreateLambda([URL]()
 			{
+				FJamLicenseBudgetScope BudgetScope(TEXT("ViewSource"));
 				FPlatformProcess::LaunchURL(*URL, nullptr, nullptr);
 			}));
 
@@ -482,6 +603,8 @@ private:
 
 	static void OnAssetManagerCreated()
 	{
+		FJamLicenseBudgetScope BudgetScope(TEXT("OnAssetManagerCreated"));
+
 		// Make sure there's a rule for UJamAssetLicense
 		FPrimaryAssetId DummyAssetId(UJamAssetLicense::StaticClass()->GetFName(), NAME_None);
 		FPrimaryAssetRules Rules = UAssetManager::Get().GetPrimaryAssetRules(DummyAssetId);
@@ -504,6 +627,9 @@ private:
 					FOnActionTokenExecuted::CreateStatic(&ThisClass::AddAssetLicenseToAssetRegistryRule), true));
 		}
 	}
+
+private:
+	FDelegateHandle MemoryReportHandle;
 };
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,125 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+
+#include "JamLicenseTrackerSettings.generated.h"
+
+// Where the per-license collections made by Refresh License Collections are stored
+UENUM()
+enum class EJamLicenseCollectionShareType : uint8
+{
+	// Only visible to this user, not in source control
+	Local,
+
+	// Only visible to this user, in source control
+	Private,
+
+	// Visible to everyone, in source control
+	Shared
+};
+
+// Maps assets imported from matching source files to an asset source URL
+USTRUCT()
+struct FJamSourcePathRule
+{
+	GENERATED_BODY()
+
+	// Pattern matched against the full path of the file an asset was imported from, using forward slashes
+	// (e.g., D:/Vendors/KitA/** where ** matches any number of folders and * matches within one folder)
+	UPROPERTY(EditAnywhere, Category=Rule)
+	FString Pattern;
+
+	// Treat Pattern as a regular expression instead of a glob
+	UPROPERTY(EditAnywhere, Category=Rule)
+	bool bIsRegex = false;
+
+	// The asset source URL to assign to matching assets
+	UPROPERTY(EditAnywhere, Category=Rule)
+	FString AssetSourceURL;
+};
+
+// Editor settings for the Jam License Tracker plugin
+UCLASS(config=Editor, defaultconfig, meta=(DisplayName="Jam License Tracker"))
+class UJamLicenseTrackerSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	// Should the license summary of the Content Browser selection be computed in the background as soon as the selection changes?
+	// This makes the Asset Actions context menu appear instantly for very large selections, but the summary is built from
+	// asset registry tags, which lag behind package metadata until assets are resaved (or backfilled), so it can disagree
+	// with what the menu would compute itself
+	UPROPERTY(config, EditAnywhere, Category=Performance)
+	bool bPrefetchSelectionLicenseState = false;
+
+	// Selections smaller than this are cheap enough to summarize when the context menu opens, so they aren't prefetched
+	UPROPERTY(config, EditAnywhere, Category=Performance, meta=(ClampMin=1, EditCondition=bPrefetchSelectionLicenseState))
+	int32 MinSelectionSizeToPrefetch = 256;
+
+	// When Select Associated Assets matches more assets than this, they are put in a local collection and shown in an
+	// asset picker instead of syncing the Content Browser to them (which builds the whole view in one blocking step)
+	UPROPERTY(config, EditAnywhere, Category=Performance, meta=(ClampMin=1))
+	int32 MaxAssociatedAssetsToSyncDirectly = 2000;
+
+	// The license index and other expensive parts of the plugin are set up the first time a license feature is used, or once the
+	// initial asset scan is done and the editor has had no user input for this long (0 sets everything up during editor startup;
+	// either way the index itself is built a few milliseconds per frame)
+	UPROPERTY(config, EditAnywhere, Category=Performance, meta=(ClampMin=0, Units="s"))
+	float ActivationIdleSeconds = 2.0f;
+
+	// Should packages saved before AssetSourceURL was added to MetaDataTagsForAssetRegistry have their source URLs read from disk
+	// and added to the asset registry at startup (and before cooking, harvesting or verifying containers)? Only the headers and metadata
+	// of project packages are read, results are cached per package file until it changes, and nothing is resaved
+	UPROPERTY(config, EditAnywhere, Category=Performance)
+	bool bBackfillMissingSourceURLTags = true;
+
+	// Menu builders and menu actions that take longer than this on the game thread are logged as warnings, with details
+	// such as the selection size (0 disables the warnings, see the JamLicense.Budget console command for a histogram of every call)
+	UPROPERTY(config, EditAnywhere, Category=Performance, meta=(ClampMin=0, Units="ms"))
+	float GameThreadBudgetMs = 16.0f;
+
+	// Refresh License Collections creates one collection per source URL under this parent collection
+	UPROPERTY(config, EditAnywhere, Category=Collections)
+	FName LicenseCollectionsParentName = TEXT("Licenses");
+
+	UPROPERTY(config, EditAnywhere, Category=Collections)
+	EJamLicenseCollectionShareType LicenseCollectionShareType = EJamLicenseCollectionShareType::Local;
+
+	// Rules used by the Preview/Apply Source URL Rules folder actions (and the optional Interchange pipeline), the first matching rule wins
+	UPROPERTY(config, EditAnywhere, Category=SourcePathRules)
+	TArray<FJamSourcePathRule> SourcePathRules;
+
+	// Should the source path rules leave assets that already have a source URL alone?
+	UPROPERTY(config, EditAnywhere, Category=SourcePathRules)
+	bool bSourcePathRulesOnlyFillMissingURLs = true;
+
+	// Should Content Browser tiles show a colored dot for the license state of each asset?
+	// (green: source URL with a license asset, yellow: source URL without a license asset, red: no source URL)
+	UPROPERTY(config, EditAnywhere, Category=Display)
+	bool bShowLicenseStateBadges = false;
+
+	//~UDeveloperSettings interface
+	virtual FName GetContainerName() const override { return TEXT("Project"); }
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+	//~End of UDeveloperSettings interface
+};
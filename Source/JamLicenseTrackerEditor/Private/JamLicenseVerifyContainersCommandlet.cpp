@@ -0,0 +1,333 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseVerifyContainersCommandlet.h"
+
+#include "JamAssetLicense.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseManifest.h"
+#include "JamLicenseTagBackfill.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "Async/ParallelFor.h"
+#include "AssetData.h"
+#include "HAL/FileManager.h"
+#include "IAssetRegistry.h"
+#include "IO/IoStore.h"
+#include "Misc/App.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace JamLicenseVerifyContainers
+{
+	struct FContainerContents
+	{
+		FString TocFilename;
+
+		// Empty if the container was read successfully
+		FString Error;
+
+		// Cooked filenames of every package in the container (as stored in the container directory index)
+		TArray<FString> PackageFilenames;
+
+		int32 NumPackagesWithoutFilename = 0;
+	};
+
+	// Reads the table of contents of one container (safe to call from any thread)
+	static void ReadContainer(FContainerContents& Contents)
+	{
+		FIoStoreReader Reader;
+		const FIoStatus Status = Reader.Initialize(*FPaths::ChangeExtension(Contents.TocFilename, TEXT("")), TMap<FGuid, FAES::FAESKey>());
+		if (!Status.IsOk())
+		{
+			Contents.Error = Status.ToString();
+			return;
+		}
+
+		Contents.PackageFilenames.Reserve(Reader.GetChunkCount());
+		Reader.EnumerateChunks([&Contents](const FIoStoreTocChunkInfo& ChunkInfo)
+		{
+			// Every cooked package has exactly one export bundle chunk
+			if (ChunkInfo.ChunkType == EIoChunkType::ExportBundleData)
+			{
+				if (ChunkInfo.bHasValidFileName)
+				{
+					Contents.PackageFilenames.Add(ChunkInfo.FileName);
+				}
+				else
+				{
+					++Contents.NumPackagesWithoutFilename;
+				}
+			}
+			return true;
+		});
+	}
+
+	// Maps a cooked filename (e.g., ../../../MyProject/Content/Maps/Entry.umap) back to a long package name
+	static bool CookedFilenameToPackageName(const FString& CookedFilename, FString& OutPackageName)
+	{
+		static const FString RootPrefix(TEXT("../../../"));
+		static const FString EnginePrefix(TEXT("Engine/"));
+		const FString ProjectPrefix = FString(FApp::GetProjectName()) + TEXT("/");
+
+		if (!CookedFilename.StartsWith(RootPrefix))
+		{
+			return false;
+		}
+
+		const FString RelativeFilename = CookedFilename.RightChop(RootPrefix.Len());
+		FString LocalFilename;
+		if (RelativeFilename.StartsWith(EnginePrefix))
+		{
+			LocalFilename = FPaths::EngineDir() / RelativeFilename.RightChop(EnginePrefix.Len());
+		}
+		else if (RelativeFilename.StartsWith(ProjectPrefix))
+		{
+			LocalFilename = FPaths::ProjectDir() / RelativeFilename.RightChop(ProjectPrefix.Len());
+		}
+		else
+		{
+			return false;
+		}
+
+		return FPackageName::TryConvertFilenameToLongPackageName(LocalFilename, /*out*/ OutPackageName);
+	}
+}
+
+UJamLicenseVerifyContainersCommandlet::UJamLicenseVerifyContainersCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UJamLicenseVerifyContainersCommandlet::Main(const FString& Params)
+{
+	using namespace JamLicenseVerifyContainers;
+
+	FString ContainerDir;
+	if (!FParse::Value(*Params, TEXT("Containers="), /*out*/ ContainerDir))
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Missing -Containers=<directory containing .utoc files>"));
+		return 1;
+	}
+
+	FString ManifestFilename = FJamLicenseManifest::GetDefaultFilename();
+	FParse::Value(*Params, TEXT("Manifest="), /*out*/ ManifestFilename);
+
+	FString PlatformString;
+	FParse::Value(*Params, TEXT("Platform="), /*out*/ PlatformString);
+	const FName PlatformName = PlatformString.IsEmpty() ? NAME_None : FName(*PlatformString);
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumErrors = 0;
+
+	// Read every container's table of contents in parallel (each read is synchronous), before loading anything else
+	TArray<FString> TocFilenames;
+	IFileManager::Get().FindFilesRecursive(/*out*/ TocFilenames, *ContainerDir, TEXT("*.utoc"), /*Files=*/ true, /*Directories=*/ false);
+	if (TocFilenames.Num() == 0)
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("No .utoc files found under %s"), *ContainerDir);
+		return 1;
+	}
+
+	TArray<FContainerContents> Containers;
+	Containers.SetNum(TocFilenames.Num());
+	for (int32 Index = 0; Index < TocFilenames.Num(); ++Index)
+	{
+		Containers[Index].TocFilename = TocFilenames[Index];
+	}
+
+	ParallelFor(Containers.Num(), [&Containers](int32 Index)
+	{
+		ReadContainer(Containers[Index]);
+	});
+
+	// Gather the shipped package list, remembering the first container each package was seen in for reporting
+	TMap<FName, int32> ShippedPackages;
+	for (int32 ContainerIndex = 0; ContainerIndex < Containers.Num(); ++ContainerIndex)
+	{
+		const FContainerContents& Container = Containers[ContainerIndex];
+		if (!Container.Error.IsEmpty())
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to read %s: %s"), *Container.TocFilename, *Container.Error);
+			++NumErrors;
+			continue;
+		}
+
+		if (Container.NumPackagesWithoutFilename > 0)
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s has %d packages with no filename (is the directory index encrypted or stripped?), they cannot be verified"), *Container.TocFilename, Container.NumPackagesWithoutFilename);
+			++NumErrors;
+		}
+
+		for (const FString& CookedFilename : Container.PackageFilenames)
+		{
+			FString PackageName;
+			if (CookedFilenameToPackageName(CookedFilename, /*out*/ PackageName))
+			{
+				ShippedPackages.Add(FName(*PackageName), ContainerIndex);
+			}
+			else
+			{
+				UE_LOG(LogJamLicenseTracker, Warning, TEXT("Could not map %s in %s to a package name, it will not be verified"), *CookedFilename, *Container.TocFilename);
+			}
+		}
+	}
+
+	const double ContainersReadTime = FPlatformTime::Seconds();
+
+	// License data from the asset registry
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(/*bSynchronousSearch=*/ true);
+
+	// Packages saved before the tag was collected would otherwise look like they have no source URL
+	if ((FJamLicenseTagBackfill::IsEnabled() || FParse::Param(*Params, TEXT("Backfill"))) && !FParse::Param(*Params, TEXT("NoBackfill")))
+	{
+		FJamLicenseTagBackfill::Run();
+	}
+
+	const FName NAME_AssetSourceURL(MD_AssetSourceURL);
+	const FName LicenseClassName = UJamAssetLicense::StaticClass()->GetFName();
+
+	TSet<FString> LicensedURLs;
+	TArray<FAssetData> LicenseAssets;
+	AssetRegistry.GetAssetsByClass(LicenseClassName, /*out*/ LicenseAssets);
+	for (const FAssetData& LicenseData : LicenseAssets)
+	{
+		LicensedURLs.Add(LicenseData.GetTagValueRef<FString>(NAME_AssetSourceURL));
+	}
+
+	TArray<FAssetData> TaggedAssets;
+	AssetRegistry.GetAssetsByTags({ NAME_AssetSourceURL }, /*out*/ TaggedAssets);
+
+	// The harvested manifest, if there is one
+	FJamLicenseManifest Manifest;
+	bool bHaveManifest = false;
+	if (IFileManager::Get().FileExists(*ManifestFilename))
+	{
+		FString ManifestError;
+		bHaveManifest = Manifest.LoadFromFile(ManifestFilename, /*out*/ ManifestError);
+		if (!bHaveManifest)
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s"), *ManifestError);
+			++NumErrors;
+		}
+	}
+	else
+	{
+		UE_LOG(LogJamLicenseTracker, Warning, TEXT("No license manifest at %s (run -run=JamLicenseHarvest first), only checking against the asset registry"), *ManifestFilename);
+	}
+
+	TMap<FName, TArray<const FJamLicenseManifestEntry*, TInlineAllocator<1>>> ManifestEntriesByPackage;
+	for (const FJamLicenseManifestEntry& Entry : Manifest.Licenses)
+	{
+		for (FName PackageName : Entry.Packages)
+		{
+			ManifestEntriesByPackage.FindOrAdd(PackageName).Add(&Entry);
+		}
+	}
+
+	// Check every shipped asset that has a source URL
+	int32 NumLicensedAssetsChecked = 0;
+	TSet<FName> ReportedPackages;
+	for (const FAssetData& AssetData : TaggedAssets)
+	{
+		const int32* pContainerIndex = ShippedPackages.Find(AssetData.PackageName);
+		if ((pContainerIndex == nullptr) || (AssetData.AssetClass == LicenseClassName))
+		{
+			continue;
+		}
+
+		const FString URL = AssetData.GetTagValueRef<FString>(NAME_AssetSourceURL);
+		if (URL.IsEmpty())
+		{
+			continue;
+		}
+
+		++NumLicensedAssetsChecked;
+		const FString ContainerFilename = FPaths::GetCleanFilename(Containers[*pContainerIndex].TocFilename);
+
+		if (!LicensedURLs.Contains(URL))
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s (in %s) uses %s, which has no license asset"), *AssetData.ObjectPath.ToString(), *ContainerFilename, *URL);
+			++NumErrors;
+		}
+
+		if (!bHaveManifest)
+		{
+			continue;
+		}
+
+		const FJamLicenseManifestEntry* ManifestEntry = nullptr;
+		if (const auto* pEntries = ManifestEntriesByPackage.Find(AssetData.PackageName))
+		{
+			for (const FJamLicenseManifestEntry* Candidate : *pEntries)
+			{
+				if (Candidate->AssetSourceURL == URL)
+				{
+					ManifestEntry = Candidate;
+					break;
+				}
+			}
+		}
+
+		if (ManifestEntry == nullptr)
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s (in %s) uses %s, but the manifest does not list it under that URL (is the manifest stale?)"), *AssetData.ObjectPath.ToString(), *ContainerFilename, *URL);
+			++NumErrors;
+		}
+		else if (ManifestEntry->LicenseAsset.IsEmpty())
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s (in %s) uses %s, which had no license when the manifest was harvested"), *AssetData.ObjectPath.ToString(), *ContainerFilename, *URL);
+			++NumErrors;
+		}
+		else if (!PlatformName.IsNone() && (ManifestEntry->AllowedPlatforms.Num() > 0) && !ManifestEntry->AllowedPlatforms.Contains(PlatformName) && !ReportedPackages.Contains(AssetData.PackageName))
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("%s (in %s) shipped for %s, but the license for %s does not allow that platform"), *AssetData.PackageName.ToString(), *ContainerFilename, *PlatformName.ToString(), *URL);
+			ReportedPackages.Add(AssetData.PackageName);
+			++NumErrors;
+		}
+	}
+
+	// The other direction is informational, since the manifest covers every package in the project and not everything gets cooked
+	int32 NumManifestPackagesNotShipped = 0;
+	for (const auto& Pair : ManifestEntriesByPackage)
+	{
+		if (!ShippedPackages.Contains(Pair.Key))
+		{
+			UE_LOG(LogJamLicenseTracker, Verbose, TEXT("%s is in the manifest but not in any container"), *Pair.Key.ToString());
+			++NumManifestPackagesNotShipped;
+		}
+	}
+
+	const double EndTime = FPlatformTime::Seconds();
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("Read %d containers (%d packages) in %.2f s, checked %d assets with a source URL in %.2f s"),
+		Containers.Num(), ShippedPackages.Num(), ContainersReadTime - StartTime, NumLicensedAssetsChecked, EndTime - ContainersReadTime);
+	if (bHaveManifest)
+	{
+		UE_LOG(LogJamLicenseTracker, Display, TEXT("%d packages in the manifest did not ship in any container"), NumManifestPackagesNotShipped);
+	}
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("License verification %s with %d errors"), (NumErrors == 0) ? TEXT("passed") : TEXT("failed"), NumErrors);
+
+	return (NumErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "JamLicenseVerifyContainersCommandlet.generated.h"
+
+// Checks the packages that actually ended up in cooked IoStore containers against the license data in the asset
+// registry and a harvested license manifest (see UJamLicenseHarvestCommandlet)
+//
+// Usage: UnrealEditor-Cmd.exe MyProject.uproject -run=JamLicenseVerifyContainers -Containers=Path/To/Paks
+//     [-Manifest=Path/To/LicenseManifest.json] [-Platform=Windows] [-Backfill|-NoBackfill]
+//
+// Only the .utoc files are read (never the .ucas payloads), all containers in parallel. Every shipped package with a
+// source URL must have a license asset for that URL and must be listed under that URL in the manifest, and if
+// -Platform is given, the license must allow that platform. Returns non-zero if any check fails
+//
+// Source URL tags missing from packages saved before the tag was collected are backfilled first (see FJamLicenseTagBackfill)
+// when Backfill Missing Source URL Tags is on in the plugin settings, or with -Backfill. -NoBackfill skips that
+UCLASS()
+class UJamLicenseVerifyContainersCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJamLicenseVerifyContainersCommandlet();
+
+	//~UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~End of UCommandlet interface
+};
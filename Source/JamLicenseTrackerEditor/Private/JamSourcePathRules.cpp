@@ -0,0 +1,389 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamSourcePathRules.h"
+
+#include "JamLicenseEditorActivation.h"
+#include "JamLicenseIndex.h"
+#include "JamLicenseTrackerLog.h"
+#include "JamLicenseTrackerSettings.h"
+
+#include "AssetData.h"
+#include "Async/ParallelFor.h"
+#include "EditorFramework/AssetImportData.h"
+#include "IAssetRegistry.h"
+#include "Logging/MessageLog.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ScopedTransaction.h"
+#include "UObject/MetaData.h"
+#include "UObject/Package.h"
+
+#define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
+
+int32 FJamSourcePathRuleSet::CountCaptureGroups(const FString& Regex)
+{
+	int32 NumGroups = 0;
+	bool bInCharacterClass = false;
+	for (int32 Index = 0; Index < Regex.Len(); ++Index)
+	{
+		const TCHAR Char = Regex[Index];
+		if (Char == TEXT('\\'))
+		{
+			++Index;
+		}
+		else if (bInCharacterClass)
+		{
+			bInCharacterClass = (Char != TEXT(']'));
+		}
+		else if (Char == TEXT('['))
+		{
+			bInCharacterClass = true;
+		}
+		else if (Char == TEXT('('))
+		{
+			// (?...) groups don't capture, except named groups, which still get a number: (?<name>...) and (?P<name>...)
+			// capture, while (?<=...) and (?<!...) are lookbehinds
+			const FString GroupStart = Regex.Mid(Index + 1, 4);
+			if (!GroupStart.StartsWith(TEXT("?")) ||
+				(GroupStart.StartsWith(TEXT("?<")) && !GroupStart.StartsWith(TEXT("?<=")) && !GroupStart.StartsWith(TEXT("?<!"))) ||
+				GroupStart.StartsWith(TEXT("?P<"), ESearchCase::CaseSensitive))
+			{
+				++NumGroups;
+			}
+		}
+	}
+	return NumGroups;
+}
+
+bool FJamSourcePathRuleSet::RebaseBackreferences(const FString& Regex, int32 GroupOffset, FString& OutRegex)
+{
+	const int32 NumGroups = CountCaptureGroups(Regex);
+
+	OutRegex.Reset(Regex.Len() + 8);
+	bool bInCharacterClass = false;
+	for (int32 Index = 0; Index < Regex.Len(); ++Index)
+	{
+		const TCHAR Char = Regex[Index];
+		if ((Char == TEXT('\\')) && !bInCharacterClass && (Index + 1 < Regex.Len()) && FChar::IsDigit(Regex[Index + 1]) && (Regex[Index + 1] != TEXT('0')))
+		{
+			// Like ICU, take as many digits as still name a group (so with 3 groups \12 is group 1 followed by a literal 2)
+			int32 GroupNumber = Regex[Index + 1] - TEXT('0');
+			if (GroupNumber > NumGroups)
+			{
+				return false;
+			}
+
+			int32 DigitsEnd = Index + 2;
+			while ((DigitsEnd < Regex.Len()) && FChar::IsDigit(Regex[DigitsEnd]) && ((GroupNumber * 10 + (Regex[DigitsEnd] - TEXT('0'))) <= NumGroups))
+			{
+				GroupNumber = GroupNumber * 10 + (Regex[DigitsEnd] - TEXT('0'));
+				++DigitsEnd;
+			}
+
+			// Wrapped, so a literal digit after the reference can't be read as part of the new number
+			OutRegex += FString::Printf(TEXT("(?:\\%d)"), GroupOffset + GroupNumber);
+			Index = DigitsEnd - 1;
+			continue;
+		}
+
+		OutRegex += Char;
+		if (Char == TEXT('\\'))
+		{
+			if (Index + 1 < Regex.Len())
+			{
+				OutRegex += Regex[++Index];
+			}
+		}
+		else if (bInCharacterClass)
+		{
+			bInCharacterClass = (Char != TEXT(']'));
+		}
+		else if (Char == TEXT('['))
+		{
+			bInCharacterClass = true;
+		}
+	}
+	return true;
+}
+
+FString FJamSourcePathRuleSet::GlobToRegex(const FString& Glob)
+{
+	FString Result;
+	Result.Reserve(Glob.Len() * 2);
+
+	for (int32 Index = 0; Index < Glob.Len(); ++Index)
+	{
+		const TCHAR Char = Glob[Index];
+		if (Char == TEXT('*'))
+		{
+			if ((Index + 1 < Glob.Len()) && (Glob[Index + 1] == TEXT('*')))
+			{
+				++Index;
+				if ((Index + 1 < Glob.Len()) && ((Glob[Index + 1] == TEXT('/')) || (Glob[Index + 1] == TEXT('\\'))))
+				{
+					// **/ matches zero or more whole folders
+					++Index;
+					Result += TEXT("(?:.*/)?");
+				}
+				else
+				{
+					Result += TEXT(".*");
+				}
+			}
+			else
+			{
+				Result += TEXT("[^/]*");
+			}
+		}
+		else if (Char == TEXT('?'))
+		{
+			Result += TEXT("[^/]");
+		}
+		else if ((Char == TEXT('/')) || (Char == TEXT('\\')))
+		{
+			Result += TEXT('/');
+		}
+		else
+		{
+			if (FCString::Strchr(TEXT(".^$|()[]{}+"), Char) != nullptr)
+			{
+				Result += TEXT('\\');
+			}
+			Result += Char;
+		}
+	}
+
+	return Result;
+}
+
+FJamSourcePathRuleSet::FJamSourcePathRuleSet(const TArray<FJamSourcePathRule>& Rules)
+{
+	FString CombinedPattern;
+	int32 NextGroup = 1;
+
+	for (const FJamSourcePathRule& Rule : Rules)
+	{
+		if (Rule.Pattern.IsEmpty() || Rule.AssetSourceURL.IsEmpty())
+		{
+			continue;
+		}
+
+		// Backreferences in the rule count its own groups, they have to be renumbered past the groups of earlier rules
+		// (and the group wrapping this rule)
+		FString RuleRegex;
+		if (!RebaseBackreferences(Rule.bIsRegex ? Rule.Pattern : GlobToRegex(Rule.Pattern), NextGroup, /*out*/ RuleRegex))
+		{
+			UE_LOG(LogJamLicenseTracker, Warning, TEXT("Ignoring source path rule %s, it has a backreference to a group it doesn't have"), *Rule.Pattern);
+			continue;
+		}
+
+		CombinedPattern += CombinedPattern.IsEmpty() ? TEXT("(") : TEXT("|(");
+		CombinedPattern += RuleRegex;
+		CombinedPattern += TEXT(")");
+
+		RuleGroups.Emplace(NextGroup, Rule.AssetSourceURL);
+		NextGroup += 1 + CountCaptureGroups(RuleRegex);
+	}
+
+	if (RuleGroups.Num() > 0)
+	{
+		Pattern.Emplace(FString::Printf(TEXT("(?i)^(?:%s)$"), *CombinedPattern));
+	}
+}
+
+FString FJamSourcePathRuleSet::FindURLForSourceFile(const FString& SourceFilename) const
+{
+	if (Pattern.IsSet() && !SourceFilename.IsEmpty())
+	{
+		FRegexMatcher Matcher(Pattern.GetValue(), SourceFilename);
+		if (Matcher.FindNext())
+		{
+			for (const TPair<int32, FString>& RuleGroup : RuleGroups)
+			{
+				if (Matcher.GetCaptureGroupBeginning(RuleGroup.Key) != INDEX_NONE)
+				{
+					return RuleGroup.Value;
+				}
+			}
+		}
+	}
+
+	return FString();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+FString FJamSourcePathRules::GetSourceFilename(const FAssetData& AssetData)
+{
+	FString ImportInfoJson;
+	if (!AssetData.GetTagValue(UObject::SourceFileTagName(), /*out*/ ImportInfoJson))
+	{
+		return FString();
+	}
+
+	TOptional<FAssetImportInfo> ImportInfo = FAssetImportInfo::FromJson(ImportInfoJson);
+	if (!ImportInfo.IsSet() || (ImportInfo->SourceFiles.Num() == 0))
+	{
+		return FString();
+	}
+
+	// Same resolution as UAssetImportData::ResolveImportFilename, relative paths are relative to the package file
+	FString Filename = ImportInfo->SourceFiles[0].RelativeFilename;
+	if (FPaths::IsRelative(Filename))
+	{
+		const FString PackageFilename = FPackageName::LongPackageNameToFilename(AssetData.PackageName.ToString());
+		Filename = FPaths::GetPath(PackageFilename) / Filename;
+	}
+
+	Filename = FPaths::ConvertRelativePathToFull(Filename);
+	FPaths::NormalizeFilename(Filename);
+	return Filename;
+}
+
+TArray<FJamSourcePathProposal> FJamSourcePathRules::Evaluate(const TArray<FString>& FolderPaths)
+{
+	const UJamLicenseTrackerSettings* Settings = GetDefault<UJamLicenseTrackerSettings>();
+	const FJamSourcePathRuleSet RuleSet(Settings->SourcePathRules);
+	if (RuleSet.IsEmpty())
+	{
+		return TArray<FJamSourcePathProposal>();
+	}
+
+	FARFilter Filter;
+	for (const FString& FolderPath : FolderPaths)
+	{
+		Filter.PackagePaths.Add(FName(*FolderPath));
+	}
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> Assets;
+	IAssetRegistry::GetChecked().GetAssets(Filter, /*out*/ Assets);
+
+	const FName NAME_AssetSourceURL(MD_AssetSourceURL);
+	const bool bOnlyFillMissing = Settings->bSourcePathRulesOnlyFillMissingURLs;
+
+	TArray<FJamSourcePathProposal> PerAssetProposals;
+	PerAssetProposals.SetNum(Assets.Num());
+
+	ParallelFor(Assets.Num(), [&](int32 AssetIndex)
+	{
+		const FAssetData& AssetData = Assets[AssetIndex];
+
+		FString CurrentURL;
+		AssetData.GetTagValue(NAME_AssetSourceURL, /*out*/ CurrentURL);
+		if (bOnlyFillMissing && !CurrentURL.IsEmpty())
+		{
+			return;
+		}
+
+		FString SourceFilename = GetSourceFilename(AssetData);
+		FString ProposedURL = RuleSet.FindURLForSourceFile(SourceFilename);
+		if (!ProposedURL.IsEmpty() && !ProposedURL.Equals(CurrentURL, ESearchCase::CaseSensitive))
+		{
+			FJamSourcePathProposal& Proposal = PerAssetProposals[AssetIndex];
+			Proposal.ObjectPath = AssetData.ObjectPath;
+			Proposal.SourceFilename = MoveTemp(SourceFilename);
+			Proposal.CurrentURL = MoveTemp(CurrentURL);
+			Proposal.ProposedURL = MoveTemp(ProposedURL);
+		}
+	});
+
+	PerAssetProposals.RemoveAll([](const FJamSourcePathProposal& Proposal) { return Proposal.ProposedURL.IsEmpty(); });
+	return PerAssetProposals;
+}
+
+void FJamSourcePathRules::Preview(const TArray<FString>& FolderPaths)
+{
+	const TArray<FJamSourcePathProposal> Proposals = Evaluate(FolderPaths);
+
+	FMessageLog LicenseLog("JamLicenseTracker");
+	LicenseLog.NewPage(LOCTEXT("PreviewSourceURLRulesPage", "Preview Source URL Rules"));
+
+	// The message log doesn't cope well with huge numbers of entries
+	const int32 MaxProposalsToList = 500;
+	for (int32 Index = 0; Index < FMath::Min(Proposals.Num(), MaxProposalsToList); ++Index)
+	{
+		const FJamSourcePathProposal& Proposal = Proposals[Index];
+		LicenseLog.Info(FText::Format(LOCTEXT("SourceURLRuleProposal", "{0}: '{1}' -> '{2}' (imported from {3})"),
+			FText::FromName(Proposal.ObjectPath), FText::AsCultureInvariant(Proposal.CurrentURL), FText::AsCultureInvariant(Proposal.ProposedURL), FText::AsCultureInvariant(Proposal.SourceFilename)));
+	}
+
+	LicenseLog.Info(FText::Format(LOCTEXT("SourceURLRuleSummary", "Source URL rules would change {0} {0}|plural(one=asset,other=assets)"), FText::AsNumber(Proposals.Num())));
+	if (Proposals.Num() > MaxProposalsToList)
+	{
+		LicenseLog.Info(FText::Format(LOCTEXT("SourceURLRuleTruncated", "Only the first {0} are listed"), FText::AsNumber(MaxProposalsToList)));
+	}
+	LicenseLog.Open(EMessageSeverity::Info, /*bForce=*/ true);
+}
+
+void FJamSourcePathRules::Apply(const TArray<FString>& FolderPaths)
+{
+	const TArray<FJamSourcePathProposal> Proposals = Evaluate(FolderPaths);
+	if (Proposals.Num() == 0)
+	{
+		return;
+	}
+
+	// Group by URL so the index can be told about each batch at once
+	TMap<FString, TArray<FName>> ObjectPathsByURL;
+	for (const FJamSourcePathProposal& Proposal : Proposals)
+	{
+		ObjectPathsByURL.FindOrAdd(Proposal.ProposedURL).Add(Proposal.ObjectPath);
+	}
+
+	FScopedSlowTask SlowTask((float)Proposals.Num(), LOCTEXT("ApplyingSourceURLRules", "Applying source URL rules..."));
+	SlowTask.MakeDialog(/*bShowCancelButton=*/ true);
+
+	const FScopedTransaction Transaction(LOCTEXT("ApplySourceURLRulesTransaction", "Apply Source URL Rules"));
+
+	for (const TPair<FString, TArray<FName>>& Pair : ObjectPathsByURL)
+	{
+		TArray<UObject*> ModifiedAssets;
+		for (FName ObjectPath : Pair.Value)
+		{
+			if (SlowTask.ShouldCancel())
+			{
+				break;
+			}
+			SlowTask.EnterProgressFrame();
+
+			// Writing metadata requires the package to be loaded
+			if (UObject* Asset = FSoftObjectPath(ObjectPath).TryLoad())
+			{
+				UPackage* Package = Asset->GetOutermost();
+				Package->Modify();
+				if (UMetaData* Metadata = Package->GetMetaData())
+				{
+					Metadata->SetValue(Asset, MD_AssetSourceURL, *Pair.Key);
+					ModifiedAssets.Add(Asset);
+				}
+			}
+		}
+
+		if (FJamLicenseEditorActivation::EnsureActivated())
+		{
+			FJamLicenseIndex::Get().NotifyMetaDataChanged(ModifiedAssets, Pair.Key);
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,87 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+
+struct FAssetData;
+struct FJamSourcePathRule;
+
+// All source path rules compiled into a single case-insensitive regular expression, so each source
+// file is matched against every rule in one pass (each rule is a capture group, the first group that
+// participated in the match identifies the rule that won)
+class FJamSourcePathRuleSet
+{
+public:
+	explicit FJamSourcePathRuleSet(const TArray<FJamSourcePathRule>& Rules);
+
+	bool IsEmpty() const
+	{
+		return !Pattern.IsSet();
+	}
+
+	// Returns the URL for a source file (an absolute path), or an empty string if no rule matches
+	// (safe to call from multiple threads at once)
+	FString FindURLForSourceFile(const FString& SourceFilename) const;
+
+	// Converts a glob (** for any number of folders, * within one folder, ? for one character) to a regular expression
+	static FString GlobToRegex(const FString& Glob);
+
+	// Counts the capture groups in a regular expression (named groups included), so the groups wrapping later rules can be numbered
+	static int32 CountCaptureGroups(const FString& Regex);
+
+	// Renumbers the numbered backreferences (\1 etc.) of a rule whose own groups start after GroupOffset in the combined
+	// pattern, returning false if one refers to a group the rule doesn't have
+	static bool RebaseBackreferences(const FString& Regex, int32 GroupOffset, FString& OutRegex);
+
+private:
+	TOptional<FRegexPattern> Pattern;
+
+	// For each rule in the combined pattern, the capture group that wraps it and the URL it assigns
+	TArray<TPair<int32, FString>> RuleGroups;
+};
+
+// A proposed change to the source URL of one asset
+struct FJamSourcePathProposal
+{
+	FName ObjectPath;
+	FString SourceFilename;
+	FString CurrentURL;
+	FString ProposedURL;
+};
+
+// Evaluates the source path rules from the plugin settings against the asset registry, without loading any assets
+class FJamSourcePathRules
+{
+public:
+	// Returns the source URL changes the rules would make to assets in (or below) the specified folders
+	static TArray<FJamSourcePathProposal> Evaluate(const TArray<FString>& FolderPaths);
+
+	// Logs the proposals to the message log
+	static void Preview(const TArray<FString>& FolderPaths);
+
+	// Evaluates the rules and writes the proposed source URLs, which does load the affected assets
+	static void Apply(const TArray<FString>& FolderPaths);
+
+	// Returns the first source filename recorded in the asset registry for an asset, as an absolute path
+	static FString GetSourceFilename(const FAssetData& AssetData);
+};
@@ -0,0 +1,117 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamSourcePathRules.h"
+
+#include "JamLicenseTrackerSettings.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JamSourcePathRulesTests
+{
+	static FJamSourcePathRule MakeRule(const TCHAR* Pattern, bool bIsRegex, const TCHAR* AssetSourceURL)
+	{
+		FJamSourcePathRule Rule;
+		Rule.Pattern = Pattern;
+		Rule.bIsRegex = bIsRegex;
+		Rule.AssetSourceURL = AssetSourceURL;
+		return Rule;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJamSourcePathRulesGlobToRegexTest, "JamLicenseTracker.SourcePathRules.GlobToRegex", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FJamSourcePathRulesGlobToRegexTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("* stays within a folder"), FJamSourcePathRuleSet::GlobToRegex(TEXT("D:/Art/*.fbx")), FString(TEXT("D:/Art/[^/]*\\.fbx")));
+	TestEqual(TEXT("? is one character"), FJamSourcePathRuleSet::GlobToRegex(TEXT("a?c")), FString(TEXT("a[^/]c")));
+	TestEqual(TEXT("**/ is zero or more folders"), FJamSourcePathRuleSet::GlobToRegex(TEXT("D:/Art/**/x.fbx")), FString(TEXT("D:/Art/(?:.*/)?x\\.fbx")));
+	TestEqual(TEXT("** without a slash is anything"), FJamSourcePathRuleSet::GlobToRegex(TEXT("D:/Art/**")), FString(TEXT("D:/Art/.*")));
+	TestEqual(TEXT("Backslashes become slashes"), FJamSourcePathRuleSet::GlobToRegex(TEXT("D:\\Art\\**\\x")), FString(TEXT("D:/Art/(?:.*/)?x")));
+	TestEqual(TEXT("Regex characters are escaped"), FJamSourcePathRuleSet::GlobToRegex(TEXT("a(1)+[b]{c}|^$")), FString(TEXT("a\\(1\\)\\+\\[b\\]\\{c\\}\\|\\^\\$")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJamSourcePathRulesCountCaptureGroupsTest, "JamLicenseTracker.SourcePathRules.CountCaptureGroups", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FJamSourcePathRulesCountCaptureGroupsTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("No groups"), FJamSourcePathRuleSet::CountCaptureGroups(TEXT("abc")), 0);
+	TestEqual(TEXT("Plain groups"), FJamSourcePathRuleSet::CountCaptureGroups(TEXT("(a)(b(c))")), 3);
+	TestEqual(TEXT("Non-capturing groups"), FJamSourcePathRuleSet::CountCaptureGroups(TEXT("(?:a)(?i:b)(c)")), 1);
+	TestEqual(TEXT("Named groups"), FJamSourcePathRuleSet::CountCaptureGroups(TEXT("(?<x>a)(?P<y>b)")), 2);
+	TestEqual(TEXT("Lookarounds"), FJamSourcePathRuleSet::CountCaptureGroups(TEXT("(?<=a)(?<!b)(?=c)(?!d)")), 0);
+	TestEqual(TEXT("Escaped parentheses"), FJamSourcePathRuleSet::CountCaptureGroups(TEXT("\\(a\\)(b)")), 1);
+	TestEqual(TEXT("Parentheses in a character class"), FJamSourcePathRuleSet::CountCaptureGroups(TEXT("[()](a)[\\]()]")), 1);
+	TestEqual(TEXT("Glob output"), FJamSourcePathRuleSet::CountCaptureGroups(FJamSourcePathRuleSet::GlobToRegex(TEXT("a(b)/**/c"))), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJamSourcePathRulesRebaseBackreferencesTest, "JamLicenseTracker.SourcePathRules.RebaseBackreferences", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FJamSourcePathRulesRebaseBackreferencesTest::RunTest(const FString& Parameters)
+{
+	FString Rebased;
+
+	TestTrue(TEXT("Valid backreference"), FJamSourcePathRuleSet::RebaseBackreferences(TEXT("(\\w+)/\\1"), 4, /*out*/ Rebased));
+	TestEqual(TEXT("Backreference is offset"), Rebased, FString(TEXT("(\\w+)/(?:\\5)")));
+
+	TestTrue(TEXT("Trailing digit"), FJamSourcePathRuleSet::RebaseBackreferences(TEXT("(a)\\12"), 1, /*out*/ Rebased));
+	TestEqual(TEXT("Trailing digit stays a literal"), Rebased, FString(TEXT("(a)(?:\\2)2")));
+
+	TestTrue(TEXT("No backreferences"), FJamSourcePathRuleSet::RebaseBackreferences(TEXT("a\\\\1[\\1]\\d"), 7, /*out*/ Rebased));
+	TestEqual(TEXT("Escaped backslashes and character classes are untouched"), Rebased, FString(TEXT("a\\\\1[\\1]\\d")));
+
+	TestFalse(TEXT("Backreference past the rule's groups"), FJamSourcePathRuleSet::RebaseBackreferences(TEXT("(a)\\2"), 1, /*out*/ Rebased));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FJamSourcePathRulesFirstMatchTest, "JamLicenseTracker.SourcePathRules.FirstMatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FJamSourcePathRulesFirstMatchTest::RunTest(const FString& Parameters)
+{
+	using namespace JamSourcePathRulesTests;
+
+	TArray<FJamSourcePathRule> Rules;
+	Rules.Add(MakeRule(TEXT("D:/Art/Kit/**/*.fbx"), false, TEXT("https://example.com/kit")));
+	Rules.Add(MakeRule(TEXT("D:/Art/(\\w+)/(\\w+)/\\2\\.fbx"), true, TEXT("https://example.com/repeated")));
+	Rules.Add(MakeRule(TEXT(""), false, TEXT("https://example.com/empty")));
+	Rules.Add(MakeRule(TEXT("D:/Art/(a)\\3"), true, TEXT("https://example.com/invalid")));
+	Rules.Add(MakeRule(TEXT("D:/Art/**"), false, TEXT("https://example.com/art")));
+
+	AddExpectedError(TEXT("backreference to a group it doesn't have"), EAutomationExpectedErrorFlags::Contains, 1);
+	const FJamSourcePathRuleSet RuleSet(Rules);
+	TestFalse(TEXT("Rule set has rules"), RuleSet.IsEmpty());
+
+	TestEqual(TEXT("First rule wins over a later one"), RuleSet.FindURLForSourceFile(TEXT("D:/Art/Kit/Props/Chair.fbx")), FString(TEXT("https://example.com/kit")));
+	TestEqual(TEXT("Matching is case-insensitive"), RuleSet.FindURLForSourceFile(TEXT("d:/art/kit/Chair.FBX")), FString(TEXT("https://example.com/kit")));
+	TestEqual(TEXT("Backreference uses its own rule's group"), RuleSet.FindURLForSourceFile(TEXT("D:/Art/Trees/Oak/Oak.fbx")), FString(TEXT("https://example.com/repeated")));
+	TestEqual(TEXT("Backreference mismatch falls through"), RuleSet.FindURLForSourceFile(TEXT("D:/Art/Trees/Oak/Elm.fbx")), FString(TEXT("https://example.com/art")));
+	TestEqual(TEXT("No rule matches"), RuleSet.FindURLForSourceFile(TEXT("E:/Other/Chair.fbx")), FString());
+
+	const FJamSourcePathRuleSet EmptyRuleSet(TArray<FJamSourcePathRule>{});
+	TestTrue(TEXT("Empty rule set"), EmptyRuleSet.IsEmpty());
+	TestEqual(TEXT("Empty rule set matches nothing"), EmptyRuleSet.FindURLForSourceFile(TEXT("D:/Art/Chair.fbx")), FString());
+	return true;
+}
+
+#endif
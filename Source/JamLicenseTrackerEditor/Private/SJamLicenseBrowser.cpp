@@ -0,0 +1,336 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SJamLicenseBrowser.h"
+
+#include "JamLicenseCollections.h"
+#include "JamLicenseEditorActivation.h"
+#include "JamLicenseIndex.h"
+
+#include "IAssetRegistry.h"
+#include "ContentBrowserModule.h"
+#include "Framework/Docking/TabManager.h"
+#include "IContentBrowserSingleton.h"
+#include "Modules/ModuleManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SListView.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+
+#define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
+
+const FName SJamLicenseBrowser::TabName(TEXT("JamLicenseBrowser"));
+const FName SJamLicenseBrowser::ColumnId_Asset(TEXT("Asset"));
+const FName SJamLicenseBrowser::ColumnId_SourceURL(TEXT("SourceURL"));
+const FName SJamLicenseBrowser::ColumnId_LicenseAsset(TEXT("LicenseAsset"));
+const FName SJamLicenseBrowser::ColumnId_SPDX(TEXT("SPDX"));
+
+class SJamLicenseBrowserRow : public SMultiColumnTableRow<FJamLicenseBrowserRowPtr>
+{
+public:
+	SLATE_BEGIN_ARGS(SJamLicenseBrowserRow) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable, FJamLicenseBrowserRowPtr InItem)
+	{
+		Item = InItem;
+		SMultiColumnTableRow<FJamLicenseBrowserRowPtr>::Construct(FSuperRowType::FArguments(), InOwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+		const FJamLicenseURLSortData& SortData = Index.GetURLSortData();
+
+		FText Text;
+		if (ColumnName == SJamLicenseBrowser::ColumnId_Asset)
+		{
+			Text = FText::FromName(Item->ObjectPath);
+		}
+		else if (ColumnName == SJamLicenseBrowser::ColumnId_SourceURL)
+		{
+			Text = FText::AsCultureInvariant(Index.GetURL(Item->URLId));
+		}
+		else if (ColumnName == SJamLicenseBrowser::ColumnId_LicenseAsset)
+		{
+			const FName LicenseAsset = SortData.LicenseAsset.IsValidIndex(Item->URLId) ? SortData.LicenseAsset[Item->URLId] : NAME_None;
+			Text = LicenseAsset.IsNone() ? LOCTEXT("NoLicenseAsset", "[no license asset]") : FText::FromName(LicenseAsset);
+		}
+		else if (ColumnName == SJamLicenseBrowser::ColumnId_SPDX)
+		{
+			Text = SortData.SPDXIdentifier.IsValidIndex(Item->URLId) ? FText::AsCultureInvariant(SortData.SPDXIdentifier[Item->URLId]) : FText::GetEmpty();
+		}
+
+		return SNew(STextBlock)
+			.Text(Text)
+			.ToolTipText(Text);
+	}
+
+private:
+	FJamLicenseBrowserRowPtr Item;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+void SJamLicenseBrowser::Construct(const FArguments& InArgs)
+{
+	SortColumn = ColumnId_SourceURL;
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(this, &SJamLicenseBrowser::GetSummaryText)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("RefreshLicenseCollections", "Refresh License Collections"))
+				.ToolTipText(LOCTEXT("RefreshLicenseCollections_Tooltip", "Creates or updates one Content Browser collection per source URL"))
+				.OnClicked_Lambda([]()
+				{
+					FJamLicenseCollections::RefreshLicenseCollections();
+					return FReply::Handled();
+				})
+			]
+		]
+		+SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		[
+			SAssignNew(ListView, SListView<FJamLicenseBrowserRowPtr>)
+			.ListItemsSource(&Rows)
+			.SelectionMode(ESelectionMode::Multi)
+			.OnGenerateRow(this, &SJamLicenseBrowser::OnGenerateRow)
+			.OnMouseButtonDoubleClick(this, &SJamLicenseBrowser::OnRowDoubleClicked)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+SHeaderRow::Column(ColumnId_Asset)
+				.DefaultLabel(LOCTEXT("AssetColumn", "Asset"))
+				.FillWidth(0.3f)
+				.SortMode(this, &SJamLicenseBrowser::GetColumnSortMode, ColumnId_Asset)
+				.OnSort(this, &SJamLicenseBrowser::OnColumnSortModeChanged)
+				+SHeaderRow::Column(ColumnId_SourceURL)
+				.DefaultLabel(LOCTEXT("SourceURLColumn", "Source URL"))
+				.FillWidth(0.3f)
+				.SortMode(this, &SJamLicenseBrowser::GetColumnSortMode, ColumnId_SourceURL)
+				.OnSort(this, &SJamLicenseBrowser::OnColumnSortModeChanged)
+				+SHeaderRow::Column(ColumnId_LicenseAsset)
+				.DefaultLabel(LOCTEXT("LicenseAssetColumn", "License Asset"))
+				.FillWidth(0.3f)
+				.SortMode(this, &SJamLicenseBrowser::GetColumnSortMode, ColumnId_LicenseAsset)
+				.OnSort(this, &SJamLicenseBrowser::OnColumnSortModeChanged)
+				+SHeaderRow::Column(ColumnId_SPDX)
+				.DefaultLabel(LOCTEXT("SPDXColumn", "SPDX"))
+				.FillWidth(0.1f)
+				.SortMode(this, &SJamLicenseBrowser::GetColumnSortMode, ColumnId_SPDX)
+				.OnSort(this, &SJamLicenseBrowser::OnColumnSortModeChanged)
+			)
+		]
+	];
+
+	RebuildRows();
+
+	RegisterActiveTimer(0.5f, FWidgetActiveTimerDelegate::CreateSP(this, &SJamLicenseBrowser::PollForIndexChanges));
+}
+
+TSharedRef<ITableRow> SJamLicenseBrowser::OnGenerateRow(FJamLicenseBrowserRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SJamLicenseBrowserRow, OwnerTable, Item);
+}
+
+void SJamLicenseBrowser::OnRowDoubleClicked(FJamLicenseBrowserRowPtr Item)
+{
+	TArray<FAssetData> AssetsToSync;
+	for (const FJamLicenseBrowserRowPtr& SelectedItem : ListView->GetSelectedItems())
+	{
+		FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(SelectedItem->ObjectPath);
+		if (AssetData.IsValid())
+		{
+			AssetsToSync.Add(MoveTemp(AssetData));
+		}
+	}
+
+	if (AssetsToSync.Num() > 0)
+	{
+		FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+		ContentBrowserModule.Get().SyncBrowserToAssets(AssetsToSync, /*bAllowLockedBrowsers=*/ false, /*bFocusContentBrowser=*/ true);
+	}
+}
+
+EColumnSortMode::Type SJamLicenseBrowser::GetColumnSortMode(FName ColumnId) const
+{
+	return (ColumnId == SortColumn) ? SortMode : EColumnSortMode::None;
+}
+
+void SJamLicenseBrowser::OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type InSortMode)
+{
+	SortColumn = ColumnId;
+	SortMode = InSortMode;
+	SortRows();
+}
+
+EActiveTimerReturnType SJamLicenseBrowser::PollForIndexChanges(double InCurrentTime, float InDeltaTime)
+{
+	if (FJamLicenseIndex::Get().GetVersion() != BuiltForVersion)
+	{
+		RebuildRows();
+	}
+	return EActiveTimerReturnType::Continue;
+}
+
+void SJamLicenseBrowser::RebuildRows()
+{
+	FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	BuiltForVersion = Index.GetVersion();
+
+	const TMap<FName, int32>& AssetURLIds = Index.GetAssetURLIds();
+
+	// The rows are all new objects, so carry the selection over by object path
+	TSet<FName> SelectedPaths;
+	if (ListView.IsValid())
+	{
+		for (const FJamLicenseBrowserRowPtr& SelectedItem : ListView->GetSelectedItems())
+		{
+			SelectedPaths.Add(SelectedItem->ObjectPath);
+		}
+		ListView->ClearSelection();
+	}
+
+	Rows.Reset(AssetURLIds.Num());
+	for (const TPair<FName, int32>& Pair : AssetURLIds)
+	{
+		FJamLicenseBrowserRowPtr Row = MakeShared<FJamLicenseBrowserRow>();
+		Row->ObjectPath = Pair.Key;
+		Row->URLId = Pair.Value;
+		Rows.Add(MoveTemp(Row));
+	}
+
+	// Object paths are the only column without a precomputed rank, so give them one now
+	Rows.Sort([](const FJamLicenseBrowserRowPtr& A, const FJamLicenseBrowserRowPtr& B) { return A->ObjectPath.LexicalLess(B->ObjectPath); });
+
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+	{
+		Rows[RowIndex]->PathRank = RowIndex;
+	}
+
+	if (SelectedPaths.Num() > 0)
+	{
+		for (const FJamLicenseBrowserRowPtr& Row : Rows)
+		{
+			if (SelectedPaths.Contains(Row->ObjectPath))
+			{
+				ListView->SetItemSelection(Row, true, ESelectInfo::Direct);
+			}
+		}
+	}
+
+	SortRows();
+}
+
+void SJamLicenseBrowser::SortRows()
+{
+	const FJamLicenseURLSortData& SortData = FJamLicenseIndex::Get().GetURLSortData();
+
+	const TArray<int32>* URLRanks = nullptr;
+	if (SortColumn == ColumnId_SourceURL)
+	{
+		URLRanks = &SortData.URLRank;
+	}
+	else if (SortColumn == ColumnId_LicenseAsset)
+	{
+		URLRanks = &SortData.LicenseAssetRank;
+	}
+	else if (SortColumn == ColumnId_SPDX)
+	{
+		URLRanks = &SortData.SPDXRank;
+	}
+
+	const bool bAscending = (SortMode != EColumnSortMode::Descending);
+	if (URLRanks != nullptr)
+	{
+		const TArray<int32>& Ranks = *URLRanks;
+		Rows.Sort([&Ranks, bAscending](const FJamLicenseBrowserRowPtr& A, const FJamLicenseBrowserRowPtr& B)
+		{
+			const int32 RankA = Ranks[A->URLId];
+			const int32 RankB = Ranks[B->URLId];
+			if (RankA != RankB)
+			{
+				return bAscending ? (RankA < RankB) : (RankA > RankB);
+			}
+			return A->PathRank < B->PathRank;
+		});
+	}
+	else
+	{
+		Rows.Sort([bAscending](const FJamLicenseBrowserRowPtr& A, const FJamLicenseBrowserRowPtr& B)
+		{
+			return bAscending ? (A->PathRank < B->PathRank) : (A->PathRank > B->PathRank);
+		});
+	}
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+FText SJamLicenseBrowser::GetSummaryText() const
+{
+	return FText::Format(LOCTEXT("LicenseBrowserSummary", "{0} {0}|plural(one=asset has,other=assets have) a source URL (double-click to find in the Content Browser)"), FText::AsNumber(Rows.Num()));
+}
+
+void SJamLicenseBrowser::RegisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(TabName, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs& Args)
+	{
+		// The tab opens right away, its content replaces a placeholder once the index has been built
+		return SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab)
+			[
+				FJamLicenseEditorActivation::MakeWidgetWhenActivated([]() -> TSharedRef<SWidget> { return SNew(SJamLicenseBrowser); })
+			];
+	}))
+	.SetDisplayName(LOCTEXT("LicenseBrowserTabTitle", "License Browser"))
+	.SetTooltipText(LOCTEXT("LicenseBrowserTabTooltip", "Lists assets by source URL and license"))
+	.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void SJamLicenseBrowser::UnregisterTabSpawner()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(TabName);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
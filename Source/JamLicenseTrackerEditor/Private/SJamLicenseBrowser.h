@@ -0,0 +1,84 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/SListView.h"
+
+// One asset shown in the license browser
+struct FJamLicenseBrowserRow
+{
+	FName ObjectPath;
+	int32 URLId = INDEX_NONE;
+
+	// Position of this row when sorted by object path
+	int32 PathRank = 0;
+};
+
+using FJamLicenseBrowserRowPtr = TSharedPtr<FJamLicenseBrowserRow>;
+
+// Lists every asset that has a source URL along with its URL, license asset, and SPDX identifier
+//
+// All columns are filled from FJamLicenseIndex (never from UMetaData), and sorting only compares the
+// precomputed integer ranks, so it stays responsive with hundreds of thousands of rows
+class SJamLicenseBrowser : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SJamLicenseBrowser) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	static const FName TabName;
+	static const FName ColumnId_Asset;
+	static const FName ColumnId_SourceURL;
+	static const FName ColumnId_LicenseAsset;
+	static const FName ColumnId_SPDX;
+
+	static void RegisterTabSpawner();
+	static void UnregisterTabSpawner();
+
+private:
+	TSharedRef<ITableRow> OnGenerateRow(FJamLicenseBrowserRowPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnRowDoubleClicked(FJamLicenseBrowserRowPtr Item);
+
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+	void OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type InSortMode);
+
+	EActiveTimerReturnType PollForIndexChanges(double InCurrentTime, float InDeltaTime);
+
+	void RebuildRows();
+	void SortRows();
+
+	FText GetSummaryText() const;
+
+private:
+	// Rebuilt from scratch whenever the index changes (the list view holds on to items, so they are shared rather than pointers into an array)
+	TArray<FJamLicenseBrowserRowPtr> Rows;
+	TSharedPtr<SListView<FJamLicenseBrowserRowPtr>> ListView;
+
+	FName SortColumn;
+	EColumnSortMode::Type SortMode = EColumnSortMode::Ascending;
+
+	uint32 BuiltForVersion = 0;
+};
@@ -0,0 +1,239 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SJamLicenseCoverageTree.h"
+
+#include "JamLicenseEditorActivation.h"
+#include "JamLicenseIndex.h"
+
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "Widgets/Text/STextBlock.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+
+#define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
+
+const FName SJamLicenseCoverageTree::TabName(TEXT("JamLicenseCoverage"));
+
+void SJamLicenseFolderCoverageBar::Construct(const FArguments& InArgs, FName InFolderPath)
+{
+	FolderPath = InFolderPath;
+
+	ChildSlot
+	[
+		SNew(SHorizontalBox)
+		+SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		[
+			SNew(SBox)
+			.WidthOverride(80.0f)
+			.HeightOverride(10.0f)
+			[
+				SNew(SProgressBar)
+				.Percent(this, &SJamLicenseFolderCoverageBar::GetCoverage)
+				.FillColorAndOpacity(this, &SJamLicenseFolderCoverageBar::GetFillColor)
+			]
+		]
+		+SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		.VAlign(VAlign_Center)
+		.Padding(6.0f, 0.0f, 0.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(this, &SJamLicenseFolderCoverageBar::GetStatsText)
+		]
+	];
+}
+
+FLinearColor SJamLicenseFolderCoverageBar::GetHeatColor(float Coverage)
+{
+	const FLinearColor Red(0.8f, 0.1f, 0.1f);
+	const FLinearColor Yellow(0.9f, 0.7f, 0.0f);
+	const FLinearColor Green(0.1f, 0.7f, 0.1f);
+
+	return (Coverage < 0.5f) ? FLinearColor::LerpUsingHSV(Red, Yellow, Coverage * 2.0f) : FLinearColor::LerpUsingHSV(Yellow, Green, (Coverage - 0.5f) * 2.0f);
+}
+
+TOptional<float> SJamLicenseFolderCoverageBar::GetCoverage() const
+{
+	return FJamLicenseIndex::Get().GetFolderStats(FolderPath).GetCoverage();
+}
+
+FSlateColor SJamLicenseFolderCoverageBar::GetFillColor() const
+{
+	return GetHeatColor(FJamLicenseIndex::Get().GetFolderStats(FolderPath).GetCoverage());
+}
+
+FText SJamLicenseFolderCoverageBar::GetStatsText() const
+{
+	const FJamLicenseFolderStats Stats = FJamLicenseIndex::Get().GetFolderStats(FolderPath);
+
+	FNumberFormattingOptions PercentFormat;
+	PercentFormat.MaximumFractionalDigits = 0;
+
+	return FText::Format(LOCTEXT("FolderCoverageStats", "{0} licensed, {1} {1}|plural(one=asset,other=assets), {2} with a source URL, {3} distinct {3}|plural(one=URL,other=URLs)"),
+		FText::AsPercent(Stats.GetCoverage(), &PercentFormat),
+		FText::AsNumber(Stats.NumAssets),
+		FText::AsNumber(Stats.NumAssetsWithURL),
+		FText::AsNumber(Stats.NumDistinctURLs));
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void SJamLicenseCoverageTree::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		.HAlign(HAlign_Right)
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("RefreshCoverageTree", "Refresh Folders"))
+			.ToolTipText(LOCTEXT("RefreshCoverageTree_Tooltip", "Picks up folders added since the tree was built (the numbers update live)"))
+			.OnClicked_Lambda([this]()
+			{
+				RebuildRoots();
+				return FReply::Handled();
+			})
+		]
+		+SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		[
+			SAssignNew(TreeView, STreeView<FItemPtr>)
+			.TreeItemsSource(&RootItems)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SJamLicenseCoverageTree::OnGenerateRow)
+			.OnGetChildren(this, &SJamLicenseCoverageTree::OnGetChildren)
+		]
+	];
+
+	RebuildRoots();
+}
+
+TSharedRef<ITableRow> SJamLicenseCoverageTree::OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	FString FolderName = Item->FolderPath.ToString();
+	int32 LastSlash = INDEX_NONE;
+	if (FolderName.FindLastChar(TEXT('/'), /*out*/ LastSlash))
+	{
+		FolderName.RightChopInline(LastSlash + 1, /*bAllowShrinking=*/ false);
+	}
+
+	return SNew(STableRow<FItemPtr>, OwnerTable)
+		.ToolTipText(FText::FromName(Item->FolderPath))
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(SBox)
+				.MinDesiredWidth(200.0f)
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString(FolderName))
+				]
+			]
+			+SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			[
+				SNew(SJamLicenseFolderCoverageBar, Item->FolderPath)
+			]
+		];
+}
+
+void SJamLicenseCoverageTree::OnGetChildren(FItemPtr Item, TArray<FItemPtr>& OutChildren)
+{
+	// Children are only generated for folders that get expanded, the full tree can be very large
+	if (!Item->bChildrenGenerated)
+	{
+		TArray<FName> ChildPaths;
+		FJamLicenseIndex::Get().GetChildFolders(Item->FolderPath, /*out*/ ChildPaths);
+		MakeItems(MoveTemp(ChildPaths), Item->Children);
+		Item->bChildrenGenerated = true;
+	}
+
+	OutChildren = Item->Children;
+}
+
+void SJamLicenseCoverageTree::RebuildRoots()
+{
+	TArray<FName> RootPaths;
+	FJamLicenseIndex::Get().GetRootFolders(/*out*/ RootPaths);
+
+	RootItems.Reset();
+	MakeItems(MoveTemp(RootPaths), RootItems);
+
+	if (TreeView.IsValid())
+	{
+		TreeView->RequestTreeRefresh();
+	}
+}
+
+void SJamLicenseCoverageTree::MakeItems(TArray<FName> FolderPaths, TArray<FItemPtr>& OutItems)
+{
+	FolderPaths.Sort([](FName A, FName B) { return A.LexicalLess(B); });
+
+	const FJamLicenseIndex& Index = FJamLicenseIndex::Get();
+	for (FName FolderPath : FolderPaths)
+	{
+		// Folders stay in the rollup after their last asset is deleted, but there's nothing to show for them
+		if (Index.GetFolderStats(FolderPath).NumAssets > 0)
+		{
+			TSharedPtr<FJamLicenseCoverageTreeItem> Item = MakeShared<FJamLicenseCoverageTreeItem>();
+			Item->FolderPath = FolderPath;
+			OutItems.Add(Item);
+		}
+	}
+}
+
+void SJamLicenseCoverageTree::RegisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(TabName, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs& Args)
+	{
+		// The tab opens right away, its content replaces a placeholder once the index has been built
+		return SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab)
+			[
+				FJamLicenseEditorActivation::MakeWidgetWhenActivated([]() -> TSharedRef<SWidget> { return SNew(SJamLicenseCoverageTree); })
+			];
+	}))
+	.SetDisplayName(LOCTEXT("LicenseCoverageTabTitle", "License Coverage"))
+	.SetTooltipText(LOCTEXT("LicenseCoverageTabTooltip", "Shows how much of each content folder is covered by a license"))
+	.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void SJamLicenseCoverageTree::UnregisterTabSpawner()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(TabName);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,83 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/STreeView.h"
+
+// Heatmap bar and numbers for the license coverage of one content folder
+class SJamLicenseFolderCoverageBar : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SJamLicenseFolderCoverageBar) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, FName InFolderPath);
+
+	// Red (nothing licensed) through yellow to green (fully licensed)
+	static FLinearColor GetHeatColor(float Coverage);
+
+private:
+	TOptional<float> GetCoverage() const;
+	FSlateColor GetFillColor() const;
+	FText GetStatsText() const;
+
+private:
+	FName FolderPath;
+};
+
+struct FJamLicenseCoverageTreeItem
+{
+	FName FolderPath;
+	TArray<TSharedPtr<FJamLicenseCoverageTreeItem>> Children;
+	bool bChildrenGenerated = false;
+};
+
+// Tree of content folders colored by license coverage
+//
+// Reads the per-folder rollups maintained by FJamLicenseIndex, so painting the tree never walks the registry
+class SJamLicenseCoverageTree : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SJamLicenseCoverageTree) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	static const FName TabName;
+
+	static void RegisterTabSpawner();
+	static void UnregisterTabSpawner();
+
+private:
+	using FItemPtr = TSharedPtr<FJamLicenseCoverageTreeItem>;
+
+	TSharedRef<ITableRow> OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetChildren(FItemPtr Item, TArray<FItemPtr>& OutChildren);
+
+	void RebuildRoots();
+	static void MakeItems(TArray<FName> FolderPaths, TArray<FItemPtr>& OutItems);
+
+private:
+	TArray<FItemPtr> RootItems;
+	TSharedPtr<STreeView<FItemPtr>> TreeView;
+};
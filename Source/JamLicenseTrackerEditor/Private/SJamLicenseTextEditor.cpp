@@ -0,0 +1,194 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SJamLicenseTextEditor.h"
+
+#include "JamAssetLicense.h"
+#include "JamLicenseBudget.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "ScopedTransaction.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
+
+namespace JamLicenseTextEditor
+{
+	static FString GetText(const UJamAssetLicense& License, const FString& Culture)
+	{
+		if (Culture.IsEmpty())
+		{
+			return License.LicenseText;
+		}
+
+		const FString* LocalizedText = License.LocalizedLicenseText.Find(Culture);
+		return (LocalizedText != nullptr) ? *LocalizedText : FString();
+	}
+}
+
+void SJamLicenseTextEditor::Construct(const FArguments& InArgs)
+{
+	Licenses = InArgs._Licenses;
+	Culture = InArgs._Culture;
+
+	const UJamAssetLicense* FirstLicense = (Licenses.Num() > 0) ? Licenses[0].Get() : nullptr;
+	const FString InitialText = (FirstLicense != nullptr) ? JamLicenseTextEditor::GetText(*FirstLicense, Culture) : FString();
+	OriginalNumChars = InitialText.Len();
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		.Padding(4.0f)
+		[
+			// The text is passed as a value rather than bound, so it isn't rebuilt and compared every frame
+			SAssignNew(TextBox, SMultiLineEditableTextBox)
+			.Font(FCoreStyle::GetDefaultFontStyle("Mono", 10))
+			.Text(FText::AsCultureInvariant(InitialText))
+			.AutoWrapText(false)
+			.AlwaysShowScrollbars(true)
+			.OnTextChanged_Lambda([this](const FText&)
+			{
+				bModified = true;
+			})
+		]
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(this, &SJamLicenseTextEditor::GetStatusText)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(4.0f, 0.0f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("ApplyLicenseText", "Apply"))
+				.ToolTipText(LOCTEXT("ApplyLicenseText_Tooltip", "Writes the text to the license assets (can be undone)"))
+				.IsEnabled_Lambda([this]() { return bModified; })
+				.OnClicked(this, &SJamLicenseTextEditor::OnApplyClicked)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("CancelLicenseText", "Cancel"))
+				.OnClicked(this, &SJamLicenseTextEditor::OnCancelClicked)
+			]
+		]
+	];
+}
+
+void SJamLicenseTextEditor::OpenWindow(const TArray<TWeakObjectPtr<UJamAssetLicense>>& Licenses, const FString& Culture)
+{
+	const UJamAssetLicense* FirstLicense = (Licenses.Num() > 0) ? Licenses[0].Get() : nullptr;
+	if (FirstLicense == nullptr)
+	{
+		return;
+	}
+
+	FText Title = (Licenses.Num() == 1)
+		? FText::Format(LOCTEXT("LicenseTextEditorTitle", "License Text - {0}"), FText::FromString(FirstLicense->GetName()))
+		: FText::Format(LOCTEXT("LicenseTextEditorTitleMulti", "License Text - {0} licenses"), FText::AsNumber(Licenses.Num()));
+	if (!Culture.IsEmpty())
+	{
+		Title = FText::Format(LOCTEXT("LicenseTextEditorTitleCulture", "{0} ({1})"), Title, FText::AsCultureInvariant(Culture));
+	}
+
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(Title)
+		.ClientSize(FVector2D(900.0f, 700.0f))
+		.SupportsMinimize(false)
+		[
+			SNew(SJamLicenseTextEditor)
+			.Licenses(Licenses)
+			.Culture(Culture)
+		];
+
+	FSlateApplication::Get().AddWindow(Window);
+}
+
+FReply SJamLicenseTextEditor::OnApplyClicked()
+{
+	FJamLicenseBudgetScope BudgetScope(TEXT("ApplyLicenseText"));
+
+	const FString NewText = TextBox->GetText().ToString();
+	BudgetScope.AddContext(TEXT("Chars"), NewText.Len());
+
+	const FName PropertyName = Culture.IsEmpty() ? GET_MEMBER_NAME_CHECKED(UJamAssetLicense, LicenseText) : GET_MEMBER_NAME_CHECKED(UJamAssetLicense, LocalizedLicenseText);
+	FProperty* LicenseTextProperty = FindFProperty<FProperty>(UJamAssetLicense::StaticClass(), PropertyName);
+
+	const FScopedTransaction Transaction(LOCTEXT("EditLicenseTextTransaction", "Edit License Text"));
+	for (const TWeakObjectPtr<UJamAssetLicense>& WeakLicense : Licenses)
+	{
+		if (UJamAssetLicense* License = WeakLicense.Get())
+		{
+			License->PreEditChange(LicenseTextProperty);
+			if (Culture.IsEmpty())
+			{
+				License->LicenseText = NewText;
+			}
+			else
+			{
+				License->LocalizedLicenseText.FindOrAdd(Culture) = NewText;
+			}
+
+			FPropertyChangedEvent PropertyChangedEvent(LicenseTextProperty, EPropertyChangeType::ValueSet);
+			License->PostEditChangeProperty(PropertyChangedEvent);
+		}
+	}
+
+	CloseWindow();
+	return FReply::Handled();
+}
+
+FReply SJamLicenseTextEditor::OnCancelClicked()
+{
+	CloseWindow();
+	return FReply::Handled();
+}
+
+void SJamLicenseTextEditor::CloseWindow()
+{
+	if (TSharedPtr<SWindow> Window = FSlateApplication::Get().FindWidgetWindow(AsShared()))
+	{
+		Window->RequestDestroyWindow();
+	}
+}
+
+FText SJamLicenseTextEditor::GetStatusText() const
+{
+	// The current length isn't shown, getting it would copy the whole text out of the layout every frame
+	const FText Size = FText::Format(LOCTEXT("LicenseTextEditorOriginalSize", "{0} characters when opened"), FText::AsNumber(OriginalNumChars));
+	return bModified ? FText::Format(LOCTEXT("LicenseTextEditorModified", "{0} (modified)"), Size) : Size;
+}
+
+#undef LOCTEXT_NAMESPACE
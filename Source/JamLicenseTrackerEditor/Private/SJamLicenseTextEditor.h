@@ -0,0 +1,62 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class SMultiLineEditableTextBox;
+class UJamAssetLicense;
+
+// Standalone window for editing the text of one or more license assets (LicenseText, or one culture of LocalizedLicenseText)
+//
+// Edits stay in the window's text layout (which only re-shapes the lines that change) and are written back to the
+// assets in a single transaction when applied, instead of the details panel text box pushing the whole text through
+// the property system on every keystroke
+class SJamLicenseTextEditor : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SJamLicenseTextEditor) {}
+		SLATE_ARGUMENT(TArray<TWeakObjectPtr<UJamAssetLicense>>, Licenses)
+		// Culture of the LocalizedLicenseText entry to edit, or empty for LicenseText
+		SLATE_ARGUMENT(FString, Culture)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	// Opens an editor window for the licenses, starting from the text of the first one
+	static void OpenWindow(const TArray<TWeakObjectPtr<UJamAssetLicense>>& Licenses, const FString& Culture = FString());
+
+private:
+	FReply OnApplyClicked();
+	FReply OnCancelClicked();
+	void CloseWindow();
+
+	FText GetStatusText() const;
+
+private:
+	TArray<TWeakObjectPtr<UJamAssetLicense>> Licenses;
+	FString Culture;
+	TSharedPtr<SMultiLineEditableTextBox> TextBox;
+
+	int32 OriginalNumChars = 0;
+	bool bModified = false;
+};
@@ -0,0 +1,220 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SJamLicenseTextPreview.h"
+
+#include "JamAssetLicense.h"
+#include "JamLicenseBudget.h"
+#include "SJamLicenseTextEditor.h"
+
+#include "DetailLayoutBuilder.h"
+#include "PropertyHandle.h"
+#include "Styling/CoreStyle.h"
+#include "UObject/UObjectGlobals.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "FJamLicenseTrackerModule"
+
+// Characters shown per line before it is clipped (some licenses are pasted in as a single enormous line)
+static const int32 MaxPreviewLineLength = 400;
+
+void SJamLicenseTextPreview::Construct(const FArguments& InArgs, TSharedRef<IPropertyHandle> InPropertyHandle)
+{
+	PropertyHandle = InPropertyHandle;
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(0.0f, 2.0f)
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Font(IDetailLayoutBuilder::GetDetailFont())
+				.Text(this, &SJamLicenseTextPreview::GetSummaryText)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("EditLicenseText", "Edit..."))
+				.ToolTipText(LOCTEXT("EditLicenseText_Tooltip", "Opens the license text in its own editor window"))
+				.IsEnabled(this, &SJamLicenseTextPreview::CanEdit)
+				.OnClicked(this, &SJamLicenseTextPreview::OnEditClicked)
+			]
+		]
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(SBox)
+			.MaxDesiredHeight(InArgs._MaxHeight)
+			[
+				SAssignNew(LineListView, SListView<TSharedPtr<FString>>)
+				.ListItemsSource(&Lines)
+				.SelectionMode(ESelectionMode::None)
+				.OnGenerateRow(this, &SJamLicenseTextPreview::OnGenerateLine)
+			]
+		]
+	];
+
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddSP(this, &SJamLicenseTextPreview::OnObjectPropertyChanged);
+
+	Refresh();
+}
+
+SJamLicenseTextPreview::~SJamLicenseTextPreview()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+}
+
+void SJamLicenseTextPreview::Refresh()
+{
+	FJamLicenseBudgetScope BudgetScope(TEXT("LicenseTextPreview"));
+
+	Lines.Reset();
+	NumChars = 0;
+	bMultipleValues = false;
+
+	FString Text;
+	const FPropertyAccess::Result Result = PropertyHandle->IsValidHandle() ? PropertyHandle->GetValue(/*out*/ Text) : FPropertyAccess::Fail;
+	bMultipleValues = (Result == FPropertyAccess::MultipleValues);
+
+	if (Result == FPropertyAccess::Success)
+	{
+		NumChars = Text.Len();
+
+		const TCHAR* LineStart = *Text;
+		const TCHAR* const TextEnd = LineStart + Text.Len();
+		while (LineStart < TextEnd)
+		{
+			const TCHAR* LineEnd = LineStart;
+			while ((LineEnd < TextEnd) && (*LineEnd != TEXT('\n')))
+			{
+				++LineEnd;
+			}
+
+			int32 LineLength = UE_PTRDIFF_TO_INT32(LineEnd - LineStart);
+			if ((LineLength > 0) && (LineStart[LineLength - 1] == TEXT('\r')))
+			{
+				--LineLength;
+			}
+
+			TSharedPtr<FString> Line = MakeShared<FString>(FMath::Min(LineLength, MaxPreviewLineLength), LineStart);
+			if (LineLength > MaxPreviewLineLength)
+			{
+				Line->Append(TEXT("..."));
+			}
+			Lines.Add(MoveTemp(Line));
+
+			LineStart = LineEnd + 1;
+		}
+		BudgetScope.AddContext(TEXT("Chars"), NumChars);
+	}
+
+	if (LineListView.IsValid())
+	{
+		LineListView->RequestListRefresh();
+	}
+}
+
+void SJamLicenseTextPreview::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (!Object->IsA<UJamAssetLicense>() || !PropertyHandle->IsValidHandle())
+	{
+		return;
+	}
+
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+	if ((PropertyName != NAME_None) && (PropertyName != GET_MEMBER_NAME_CHECKED(UJamAssetLicense, LicenseText)) && (PropertyName != GET_MEMBER_NAME_CHECKED(UJamAssetLicense, LocalizedLicenseText)))
+	{
+		return;
+	}
+
+	TArray<UObject*> OuterObjects;
+	PropertyHandle->GetOuterObjects(/*out*/ OuterObjects);
+	if (OuterObjects.Contains(Object))
+	{
+		Refresh();
+	}
+}
+
+TSharedRef<ITableRow> SJamLicenseTextPreview::OnGenerateLine(TSharedPtr<FString> Line, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<TSharedPtr<FString>>, OwnerTable)
+		[
+			SNew(STextBlock)
+			.Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+			.Text(FText::AsCultureInvariant(*Line))
+		];
+}
+
+FText SJamLicenseTextPreview::GetSummaryText() const
+{
+	if (bMultipleValues)
+	{
+		return LOCTEXT("LicenseTextMultipleValues", "Multiple Values");
+	}
+	return FText::Format(LOCTEXT("LicenseTextSummary", "{0} characters, {1} lines"), FText::AsNumber(NumChars), FText::AsNumber(Lines.Num()));
+}
+
+bool SJamLicenseTextPreview::CanEdit() const
+{
+	return !bMultipleValues && PropertyHandle->IsValidHandle() && PropertyHandle->IsEditable();
+}
+
+FReply SJamLicenseTextPreview::OnEditClicked()
+{
+	TArray<UObject*> OuterObjects;
+	PropertyHandle->GetOuterObjects(/*out*/ OuterObjects);
+
+	TArray<TWeakObjectPtr<UJamAssetLicense>> Licenses;
+	for (UObject* Object : OuterObjects)
+	{
+		if (UJamAssetLicense* License = Cast<UJamAssetLicense>(Object))
+		{
+			Licenses.Add(License);
+		}
+	}
+
+	// A LocalizedLicenseText value is edited by its culture (read when clicked, since the key can be renamed while the preview is up)
+	FString Culture;
+	if (TSharedPtr<IPropertyHandle> KeyHandle = PropertyHandle->GetKeyHandle())
+	{
+		if ((KeyHandle->GetValue(/*out*/ Culture) != FPropertyAccess::Success) || Culture.IsEmpty())
+		{
+			return FReply::Handled();
+		}
+	}
+
+	if (Licenses.Num() > 0)
+	{
+		SJamLicenseTextEditor::OpenWindow(Licenses, Culture);
+	}
+	return FReply::Handled();
+}
+
+#undef LOCTEXT_NAMESPACE
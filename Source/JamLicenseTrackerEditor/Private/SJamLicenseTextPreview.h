@@ -0,0 +1,72 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorUndoClient.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class IPropertyHandle;
+struct FPropertyChangedEvent;
+
+// Read-only view of a license text property (LicenseText or a LocalizedLicenseText value), for the details panel
+//
+// The text is split into lines once per change and shown in a list view, so only the visible lines become widgets
+// (very long lines are clipped as well), and a 100 KB EULA costs about the same to show as a one line attribution.
+// Editing happens in SJamLicenseTextEditor.
+class SJamLicenseTextPreview : public SCompoundWidget, public FSelfRegisteringEditorUndoClient
+{
+public:
+	SLATE_BEGIN_ARGS(SJamLicenseTextPreview)
+		: _MaxHeight(240.0f)
+		{}
+		SLATE_ARGUMENT(float, MaxHeight)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, TSharedRef<IPropertyHandle> InPropertyHandle);
+	virtual ~SJamLicenseTextPreview();
+
+	//~FEditorUndoClient interface
+	virtual void PostUndo(bool bSuccess) override { Refresh(); }
+	virtual void PostRedo(bool bSuccess) override { Refresh(); }
+	//~End of FEditorUndoClient interface
+
+private:
+	void Refresh();
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+	TSharedRef<ITableRow> OnGenerateLine(TSharedPtr<FString> Line, const TSharedRef<STableViewBase>& OwnerTable);
+	FText GetSummaryText() const;
+	bool CanEdit() const;
+	FReply OnEditClicked();
+
+private:
+	TSharedPtr<IPropertyHandle> PropertyHandle;
+
+	TArray<TSharedPtr<FString>> Lines;
+	TSharedPtr<SListView<TSharedPtr<FString>>> LineListView;
+
+	int32 NumChars = 0;
+	bool bMultipleValues = false;
+
+	FDelegateHandle PropertyChangedHandle;
+};
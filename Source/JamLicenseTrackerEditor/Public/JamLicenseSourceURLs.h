@@ -0,0 +1,36 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Asset source URL operations for other editor modules (e.g., the optional JamLicenseTrackerInterchange plugin)
+class JAMLICENSETRACKEREDITOR_API FJamLicenseSourceURLs
+{
+public:
+	// Returns the URL the source path rules in the plugin settings pick for a source file, or an empty string if no rule matches
+	// (doesn't touch any UObjects, so it can be called from any thread)
+	static FString FindURLForSourceFile(const FString& SourceFilename);
+
+	// Sets the source URL of an asset in its package metadata and tells the license index about the unsaved edit
+	// Returns false without changing anything if bKeepExistingURL is set and the asset already has a source URL
+	static bool SetAssetSourceURL(UObject* Asset, const FString& URL, bool bKeepExistingURL);
+};
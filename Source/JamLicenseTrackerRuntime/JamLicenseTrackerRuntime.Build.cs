@@ -34,8 +34,15 @@ public class JamLicenseTrackerRuntime : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			"CoreUObject",
 			"Engine",
+			"Json",
+			"JsonUtilities",
 			"Slate",
 			"SlateCore",
 		});
+
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("TargetPlatform");
+		}
 	}
 }
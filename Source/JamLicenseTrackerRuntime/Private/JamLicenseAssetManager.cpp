@@ -0,0 +1,63 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseAssetManager.h"
+
+#include "JamLicenseCookFilter.h"
+#include "JamLicenseTrackerLog.h"
+
+#if WITH_EDITOR
+#include "Interfaces/ITargetPlatform.h"
+#endif
+
+#if WITH_EDITOR
+FSimpleMulticastDelegate UJamLicenseAssetManager::OnPreBuildCookFilter;
+
+bool UJamLicenseAssetManager::ShouldCookForPlatform(const UPackage* Package, const ITargetPlatform* TargetPlatform)
+{
+	if (!Super::ShouldCookForPlatform(Package, TargetPlatform))
+	{
+		return false;
+	}
+
+	if ((Package == nullptr) || (TargetPlatform == nullptr))
+	{
+		return true;
+	}
+
+	FString ExcludingURL;
+	const FName PlatformName(*TargetPlatform->IniPlatformName());
+	if (FJamLicenseCookFilter::Get().IsPackageAllowedOnPlatform(Package->GetFName(), PlatformName, /*out*/ ExcludingURL))
+	{
+		return true;
+	}
+
+	if (bErrorOnDisallowedPlatformLicense)
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("%s uses assets from %s, whose license does not allow %s"), *Package->GetName(), *ExcludingURL, *PlatformName.ToString());
+	}
+	else
+	{
+		UE_LOG(LogJamLicenseTracker, Display, TEXT("Not cooking %s for %s, the license for %s does not allow that platform"), *Package->GetName(), *PlatformName.ToString(), *ExcludingURL);
+	}
+
+	return false;
+}
+#endif
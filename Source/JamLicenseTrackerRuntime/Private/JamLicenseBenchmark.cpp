@@ -0,0 +1,246 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseBenchmark.h"
+
+#include "JamLicenseTrackerLog.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace JamLicenseBenchmark
+{
+	// Growth below this is noise from unrelated allocations, so it never counts as a regression
+	static constexpr uint64 MinMemoryRegressionBytes = 1024 * 1024;
+}
+
+FJamLicenseBenchmarkResult FJamLicenseBenchmarkResult::Run(const FString& Name, int32 NumIterations, TFunctionRef<void(int32 Iteration)> Body, int64 OperationsPerSample)
+{
+	FJamLicenseBenchmarkResult Result;
+	Result.Name = Name;
+	Result.OperationsPerSample = OperationsPerSample;
+
+	Result.SamplesMs.Reserve(NumIterations);
+	const uint64 UsedPhysicalAtStart = FPlatformMemory::GetStats().UsedPhysical;
+	uint64 MaxUsedPhysical = UsedPhysicalAtStart;
+
+	// Untimed warm-up, so one-off costs (first loads, lazily built tables) don't land in the samples
+	Body(-1);
+	MaxUsedPhysical = FMath::Max<uint64>(MaxUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Body(Iteration);
+		Result.SamplesMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		MaxUsedPhysical = FMath::Max<uint64>(MaxUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	}
+	Result.MemoryGrowthBytes = MaxUsedPhysical - UsedPhysicalAtStart;
+
+	Result.Finalize();
+	return Result;
+}
+
+void FJamLicenseBenchmarkResult::Finalize()
+{
+	NumSamples = SamplesMs.Num();
+	if (NumSamples == 0)
+	{
+		return;
+	}
+
+	TArray<double> Sorted = SamplesMs;
+	Sorted.Sort();
+
+	// Nearest-rank percentiles
+	auto Percentile = [&Sorted](double Fraction)
+	{
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Rank];
+	};
+
+	double Total = 0.0;
+	for (double Sample : Sorted)
+	{
+		Total += Sample;
+	}
+
+	MinMs = Sorted[0];
+	MaxMs = Sorted.Last();
+	MeanMs = Total / Sorted.Num();
+	P50Ms = Percentile(0.50);
+	P90Ms = Percentile(0.90);
+	P99Ms = Percentile(0.99);
+}
+
+TSharedRef<FJsonObject> FJamLicenseBenchmarkResult::ToJson() const
+{
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetStringField(TEXT("name"), Name);
+	Object->SetNumberField(TEXT("samples"), NumSamples);
+	Object->SetNumberField(TEXT("operationsPerSample"), (double)OperationsPerSample);
+	Object->SetNumberField(TEXT("minMs"), MinMs);
+	Object->SetNumberField(TEXT("meanMs"), MeanMs);
+	Object->SetNumberField(TEXT("p50Ms"), P50Ms);
+	Object->SetNumberField(TEXT("p90Ms"), P90Ms);
+	Object->SetNumberField(TEXT("p99Ms"), P99Ms);
+	Object->SetNumberField(TEXT("maxMs"), MaxMs);
+	Object->SetNumberField(TEXT("operationsPerSecond"), GetOperationsPerSecond());
+	Object->SetNumberField(TEXT("memoryGrowthMB"), (double)MemoryGrowthBytes / (1024.0 * 1024.0));
+	return Object;
+}
+
+FJamLicenseBenchmarkResult FJamLicenseBenchmarkResult::FromJson(const FJsonObject& Object)
+{
+	FJamLicenseBenchmarkResult Result;
+	Result.Name = Object.GetStringField(TEXT("name"));
+	Result.NumSamples = (int32)Object.GetNumberField(TEXT("samples"));
+	Result.OperationsPerSample = (int64)Object.GetNumberField(TEXT("operationsPerSample"));
+	Result.MinMs = Object.GetNumberField(TEXT("minMs"));
+	Result.MeanMs = Object.GetNumberField(TEXT("meanMs"));
+	Result.P50Ms = Object.GetNumberField(TEXT("p50Ms"));
+	Result.P90Ms = Object.GetNumberField(TEXT("p90Ms"));
+	Result.P99Ms = Object.GetNumberField(TEXT("p99Ms"));
+	Result.MaxMs = Object.GetNumberField(TEXT("maxMs"));
+
+	// Older reports recorded the process-wide peak instead, which can't be compared, so they're treated as unmeasured
+	double MemoryGrowthMB = 0.0;
+	if (Object.TryGetNumberField(TEXT("memoryGrowthMB"), /*out*/ MemoryGrowthMB))
+	{
+		Result.MemoryGrowthBytes = (uint64)(MemoryGrowthMB * 1024.0 * 1024.0);
+	}
+	return Result;
+}
+
+void FJamLicenseBenchmarkReport::AddPeakMemoryToContext()
+{
+	Context.Add(TEXT("peakUsedPhysicalMB"), FString::Printf(TEXT("%.1f"), (double)FPlatformMemory::GetStats().PeakUsedPhysical / (1024.0 * 1024.0)));
+}
+
+bool FJamLicenseBenchmarkReport::SaveToFile(const FString& Filename) const
+{
+	TSharedRef<FJsonObject> ContextObject = MakeShared<FJsonObject>();
+	for (const TPair<FString, FString>& Pair : Context)
+	{
+		ContextObject->SetStringField(Pair.Key, Pair.Value);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ResultValues;
+	for (const FJamLicenseBenchmarkResult& Result : Results)
+	{
+		ResultValues.Add(MakeShared<FJsonValueObject>(Result.ToJson()));
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetObjectField(TEXT("context"), ContextObject);
+	Root->SetArrayField(TEXT("results"), ResultValues);
+
+	FString JsonText;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+	FJsonSerializer::Serialize(Root, Writer);
+	return FFileHelper::SaveStringToFile(JsonText, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+bool FJamLicenseBenchmarkReport::LoadFromFile(const FString& Filename, FString& OutError)
+{
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(/*out*/ JsonText, *Filename))
+	{
+		OutError = FString::Printf(TEXT("Could not read %s"), *Filename);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	const TArray<TSharedPtr<FJsonValue>>* ResultValues = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, /*out*/ Root) || !Root.IsValid() || !Root->TryGetArrayField(TEXT("results"), /*out*/ ResultValues))
+	{
+		OutError = FString::Printf(TEXT("%s is not a benchmark report"), *Filename);
+		return false;
+	}
+
+	Context.Reset();
+	const TSharedPtr<FJsonObject>* ContextObject = nullptr;
+	if (Root->TryGetObjectField(TEXT("context"), /*out*/ ContextObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*ContextObject)->Values)
+		{
+			Context.Add(Pair.Key, Pair.Value->AsString());
+		}
+	}
+
+	Results.Reset();
+	for (const TSharedPtr<FJsonValue>& ResultValue : *ResultValues)
+	{
+		if (const TSharedPtr<FJsonObject> ResultObject = ResultValue->AsObject())
+		{
+			Results.Add(FJamLicenseBenchmarkResult::FromJson(*ResultObject));
+		}
+	}
+
+	return true;
+}
+
+const FJamLicenseBenchmarkResult* FJamLicenseBenchmarkReport::FindResult(const FString& Name) const
+{
+	return Results.FindByPredicate([&Name](const FJamLicenseBenchmarkResult& Result) { return Result.Name == Name; });
+}
+
+TArray<FString> FJamLicenseBenchmarkReport::FindRegressions(const FJamLicenseBenchmarkReport& Baseline, double Threshold) const
+{
+	using namespace JamLicenseBenchmark;
+
+	TArray<FString> Regressions;
+	for (const FJamLicenseBenchmarkResult& Result : Results)
+	{
+		const FJamLicenseBenchmarkResult* BaselineResult = Baseline.FindResult(Result.Name);
+		if (BaselineResult == nullptr)
+		{
+			continue;
+		}
+
+		if ((BaselineResult->P50Ms > 0.0) && (Result.P50Ms > BaselineResult->P50Ms * (1.0 + Threshold)))
+		{
+			Regressions.Add(FString::Printf(TEXT("%s: median %.3f ms vs baseline %.3f ms (+%.0f%%)"),
+				*Result.Name, Result.P50Ms, BaselineResult->P50Ms, (Result.P50Ms / BaselineResult->P50Ms - 1.0) * 100.0));
+		}
+
+		if ((BaselineResult->MemoryGrowthBytes > 0) && (Result.MemoryGrowthBytes > BaselineResult->MemoryGrowthBytes + MinMemoryRegressionBytes) &&
+			((double)Result.MemoryGrowthBytes > (double)BaselineResult->MemoryGrowthBytes * (1.0 + Threshold)))
+		{
+			Regressions.Add(FString::Printf(TEXT("%s: memory growth %.1f MB vs baseline %.1f MB"),
+				*Result.Name, (double)Result.MemoryGrowthBytes / (1024.0 * 1024.0), (double)BaselineResult->MemoryGrowthBytes / (1024.0 * 1024.0)));
+		}
+	}
+	return Regressions;
+}
+
+void FJamLicenseBenchmarkReport::LogSummary() const
+{
+	for (const FJamLicenseBenchmarkResult& Result : Results)
+	{
+		UE_LOG(LogJamLicenseTracker, Display, TEXT("%-24s n=%-5d p50=%9.3f ms  p90=%9.3f ms  p99=%9.3f ms  max=%9.3f ms  %12.0f ops/s  mem=+%.1f MB"),
+			*Result.Name, Result.NumSamples, Result.P50Ms, Result.P90Ms, Result.P99Ms, Result.MaxMs, Result.GetOperationsPerSecond(), (double)Result.MemoryGrowthBytes / (1024.0 * 1024.0));
+	}
+}
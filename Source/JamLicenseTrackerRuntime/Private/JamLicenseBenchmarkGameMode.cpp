@@ -0,0 +1,127 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseBenchmarkGameMode.h"
+
+#include "JamLicenseTrackerLog.h"
+
+#include "Async/Async.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Paths.h"
+
+AJamLicenseBenchmarkGameMode::AJamLicenseBenchmarkGameMode()
+{
+	DefaultPawnClass = nullptr;
+}
+
+void AJamLicenseBenchmarkGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	Benchmark.NumThreads = UGameplayStatics::GetIntOption(Options, TEXT("Threads"), Benchmark.NumThreads);
+	Benchmark.NumQueries = UGameplayStatics::GetIntOption(Options, TEXT("Queries"), (int32)Benchmark.NumQueries);
+	Benchmark.NumLoadIterations = UGameplayStatics::GetIntOption(Options, TEXT("LoadIterations"), Benchmark.NumLoadIterations);
+	Benchmark.ManifestFilename = UGameplayStatics::ParseOption(Options, TEXT("Manifest"));
+
+	OutputFilename = UGameplayStatics::ParseOption(Options, TEXT("Output"));
+	if (OutputFilename.IsEmpty())
+	{
+		OutputFilename = FPaths::ProjectSavedDir() / TEXT("JamLicenseTracker") / TEXT("Benchmarks") / FString::Printf(TEXT("Runtime-%s-%s.json"), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()), *FDateTime::Now().ToString());
+	}
+
+	BaselineFilename = UGameplayStatics::ParseOption(Options, TEXT("Baseline"));
+	const FString ThresholdOption = UGameplayStatics::ParseOption(Options, TEXT("Threshold"));
+	if (!ThresholdOption.IsEmpty())
+	{
+		LexFromString(/*out*/ Threshold, *ThresholdOption);
+	}
+
+	bExitWhenDone = !UGameplayStatics::HasOption(Options, TEXT("NoExit"));
+}
+
+void AJamLicenseBenchmarkGameMode::StartPlay()
+{
+	Super::StartPlay();
+
+	UE_LOG(LogJamLicenseTracker, Display, TEXT("Starting the runtime license benchmark"));
+
+	// Run off the game thread so the engine keeps ticking (and the hang detector stays quiet) during the multi-second query run
+	TWeakObjectPtr<AJamLicenseBenchmarkGameMode> WeakThis(this);
+	Async(EAsyncExecution::Thread, [WeakThis, BenchmarkSettings = Benchmark]()
+	{
+		FJamLicenseBenchmarkReport Report;
+		FString Error;
+		const bool bSuccess = BenchmarkSettings.Run(/*out*/ Report, /*out*/ Error);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, bSuccess, Report = MoveTemp(Report), Error = MoveTemp(Error)]()
+		{
+			if (AJamLicenseBenchmarkGameMode* This = WeakThis.Get())
+			{
+				This->OnBenchmarkFinished(bSuccess, Report, Error);
+			}
+		});
+	});
+}
+
+void AJamLicenseBenchmarkGameMode::OnBenchmarkFinished(bool bSuccess, const FJamLicenseBenchmarkReport& Report, const FString& Error)
+{
+	if (bSuccess)
+	{
+		Report.LogSummary();
+
+		if (Report.SaveToFile(OutputFilename))
+		{
+			UE_LOG(LogJamLicenseTracker, Display, TEXT("Wrote runtime benchmark report to %s"), *OutputFilename);
+		}
+		else
+		{
+			UE_LOG(LogJamLicenseTracker, Error, TEXT("Failed to write runtime benchmark report to %s"), *OutputFilename);
+			bSuccess = false;
+		}
+
+		if (!BaselineFilename.IsEmpty())
+		{
+			FJamLicenseBenchmarkReport Baseline;
+			FString BaselineError;
+			if (Baseline.LoadFromFile(BaselineFilename, /*out*/ BaselineError))
+			{
+				for (const FString& Regression : Report.FindRegressions(Baseline, Threshold))
+				{
+					UE_LOG(LogJamLicenseTracker, Error, TEXT("Regression: %s"), *Regression);
+					bSuccess = false;
+				}
+			}
+			else
+			{
+				UE_LOG(LogJamLicenseTracker, Error, TEXT("%s"), *BaselineError);
+				bSuccess = false;
+			}
+		}
+	}
+	else
+	{
+		UE_LOG(LogJamLicenseTracker, Error, TEXT("Runtime license benchmark failed: %s"), *Error);
+	}
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(/*Force=*/ false, bSuccess ? 0 : 1);
+	}
+}
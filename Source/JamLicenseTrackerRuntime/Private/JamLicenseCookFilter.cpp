@@ -0,0 +1,209 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseCookFilter.h"
+
+#if WITH_EDITOR
+
+#include "AssetData.h"
+#include "IAssetRegistry.h"
+#include "JamAssetLicense.h"
+#include "JamLicenseAssetManager.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseTrackerLog.h"
+#include "Misc/ScopeLock.h"
+
+FJamLicenseCookFilter& FJamLicenseCookFilter::Get()
+{
+	static FJamLicenseCookFilter Instance;
+	return Instance;
+}
+
+void FJamLicenseCookFilter::Invalidate()
+{
+	FScopeLock Lock(&BuildLock);
+	bBuilt = false;
+}
+
+FJamLicenseMemoryUsage FJamLicenseCookFilter::GetMemoryUsage()
+{
+	FScopeLock Lock(&BuildLock);
+
+	FJamLicenseMemoryUsage Usage;
+	Usage.IndexTables = PlatformBits.GetAllocatedSize() + URLs.GetAllocatedSize() + AllowedPlatformMaskByURLId.GetAllocatedSize() + RestrictedPackages.GetAllocatedSize();
+	for (const FString& URL : URLs)
+	{
+		Usage.StringPools += URL.GetAllocatedSize();
+	}
+	return Usage;
+}
+
+// Parses the exported text of a TArray<FName> tag, e.g. ("Windows","Mac") or (Windows,Mac)
+static void ParsePlatformListTag(const FString& TagValue, TArray<FName>& OutPlatforms)
+{
+	FString Cleaned = TagValue.Replace(TEXT("("), TEXT("")).Replace(TEXT(")"), TEXT("")).Replace(TEXT("\""), TEXT(""));
+
+	TArray<FString> Parts;
+	Cleaned.ParseIntoArray(Parts, TEXT(","), /*InCullEmpty=*/ true);
+	for (FString& Part : Parts)
+	{
+		Part.TrimStartAndEndInline();
+		if (!Part.IsEmpty())
+		{
+			OutPlatforms.Add(FName(*Part));
+		}
+	}
+}
+
+void FJamLicenseCookFilter::BuildIfNeeded()
+{
+	if (bBuilt)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	static bool bRegisteredForChanges = false;
+	if (!bRegisteredForChanges)
+	{
+		// Cheap to throw away and rebuild, this only matters for cooking from a long-running editor session (Invalidate takes
+		// BuildLock, the registry can report changes while a cook worker is reading the tables)
+		AssetRegistry.OnAssetAdded().AddLambda([this](const FAssetData&) { Invalidate(); });
+		AssetRegistry.OnAssetRemoved().AddLambda([this](const FAssetData&) { Invalidate(); });
+		AssetRegistry.OnAssetUpdated().AddLambda([this](const FAssetData&) { Invalidate(); });
+		FJamLicenseMemoryReport::OnGather().AddLambda([this](FJamLicenseMemoryReport& Report) { Report.Add(TEXT("CookFilter"), GetMemoryUsage()); });
+		bRegisteredForChanges = true;
+
+		// Tags added here invalidate the filter through the callbacks above, which is fine since it is built right after
+		UJamLicenseAssetManager::OnPreBuildCookFilter.Broadcast();
+	}
+
+	PlatformBits.Reset();
+	URLs.Reset();
+	AllowedPlatformMaskByURLId.Reset();
+	RestrictedPackages.Reset();
+
+	const FName NAME_AssetSourceURL(GET_MEMBER_NAME_CHECKED(UJamAssetLicense, AssetSourceURL));
+	const FName NAME_AllowedPlatforms(GET_MEMBER_NAME_CHECKED(UJamAssetLicense, AllowedPlatforms));
+	const FName LicenseClassName = UJamAssetLicense::StaticClass()->GetFName();
+
+	// Work out the allowed platforms for each URL that has a license
+	TMap<FString, int32> URLToId;
+	TArray<FAssetData> LicenseAssets;
+	AssetRegistry.GetAssetsByClass(LicenseClassName, /*out*/ LicenseAssets);
+	for (const FAssetData& LicenseData : LicenseAssets)
+	{
+		const FString URL = LicenseData.GetTagValueRef<FString>(NAME_AssetSourceURL);
+		if (URL.IsEmpty())
+		{
+			continue;
+		}
+
+		TArray<FName> Platforms;
+		ParsePlatformListTag(LicenseData.GetTagValueRef<FString>(NAME_AllowedPlatforms), /*out*/ Platforms);
+
+		uint64 Mask = AllPlatformsMask;
+		if (Platforms.Num() > 0)
+		{
+			Mask = 0;
+			for (FName Platform : Platforms)
+			{
+				int32* pBit = PlatformBits.Find(Platform);
+				if ((pBit == nullptr) && (PlatformBits.Num() < 64))
+				{
+					pBit = &PlatformBits.Add(Platform, PlatformBits.Num());
+				}
+
+				if (pBit != nullptr)
+				{
+					Mask |= (1ull << *pBit);
+				}
+				else
+				{
+					UE_LOG(LogJamLicenseTracker, Warning, TEXT("Too many distinct platform names in license AllowedPlatforms lists, ignoring %s in %s"), *Platform.ToString(), *LicenseData.ObjectPath.ToString());
+				}
+			}
+		}
+
+		// Several licenses for the same URL allow anything any of them allow
+		if (int32* pExistingId = URLToId.Find(URL))
+		{
+			AllowedPlatformMaskByURLId[*pExistingId] |= Mask;
+		}
+		else
+		{
+			URLToId.Add(URL, URLs.Add(URL));
+			AllowedPlatformMaskByURLId.Add(Mask);
+		}
+	}
+
+	// Then record which packages use a restricted URL
+	TArray<FAssetData> TaggedAssets;
+	AssetRegistry.GetAssetsByTags({ NAME_AssetSourceURL }, /*out*/ TaggedAssets);
+	for (const FAssetData& AssetData : TaggedAssets)
+	{
+		if (AssetData.AssetClass == LicenseClassName)
+		{
+			continue;
+		}
+
+		const int32* pURLId = URLToId.Find(AssetData.GetTagValueRef<FString>(NAME_AssetSourceURL));
+		if ((pURLId == nullptr) || (AllowedPlatformMaskByURLId[*pURLId] == AllPlatformsMask))
+		{
+			continue;
+		}
+
+		const uint64 URLMask = AllowedPlatformMaskByURLId[*pURLId];
+		FPackageEntry& Entry = RestrictedPackages.FindOrAdd(AssetData.PackageName);
+		if ((Entry.URLId == INDEX_NONE) || (FMath::CountBits(URLMask) < FMath::CountBits(Entry.AllowedPlatformMask)))
+		{
+			Entry.URLId = *pURLId;
+		}
+		Entry.AllowedPlatformMask &= URLMask;
+	}
+
+	bBuilt = true;
+}
+
+bool FJamLicenseCookFilter::IsPackageAllowedOnPlatform(FName PackageName, FName IniPlatformName, FString& OutExcludingURL)
+{
+	FScopeLock Lock(&BuildLock);
+	BuildIfNeeded();
+
+	const FPackageEntry* Entry = RestrictedPackages.Find(PackageName);
+	if (Entry == nullptr)
+	{
+		return true;
+	}
+
+	const int32* pBit = PlatformBits.Find(IniPlatformName);
+	if ((pBit != nullptr) && ((Entry->AllowedPlatformMask & (1ull << *pBit)) != 0))
+	{
+		return true;
+	}
+
+	OutExcludingURL = URLs[Entry->URLId];
+	return false;
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+struct FJamLicenseMemoryUsage;
+
+// Cook-time lookup of which platforms each package's license allows
+//
+// Built once from the asset registry (license assets and AssetSourceURL tags) on first use, after
+// UJamLicenseAssetManager::OnPreBuildCookFilter has given the editor a chance to backfill missing tags. Each source URL is
+// interned to an id with a bitmask of allowed platforms, so checking a package is a map lookup and a bit test
+class FJamLicenseCookFilter
+{
+public:
+	static FJamLicenseCookFilter& Get();
+
+	// Returns true if the package may be cooked for the platform, or false and the URL of the license that excludes it
+	bool IsPackageAllowedOnPlatform(FName PackageName, FName IniPlatformName, FString& OutExcludingURL);
+
+	// Forces the tables to be rebuilt on next use
+	void Invalidate();
+
+	FJamLicenseMemoryUsage GetMemoryUsage();
+
+private:
+	void BuildIfNeeded();
+
+	static constexpr uint64 AllPlatformsMask = ~0ull;
+
+private:
+	bool bBuilt = false;
+
+	FCriticalSection BuildLock;
+
+	// One bit per platform named by any license
+	TMap<FName, int32> PlatformBits;
+
+	TArray<FString> URLs;
+	TArray<uint64> AllowedPlatformMaskByURLId;
+
+	struct FPackageEntry
+	{
+		// Intersection of the masks of every URL used by assets in the package
+		uint64 AllowedPlatformMask = AllPlatformsMask;
+
+		// The most restrictive URL, for reporting
+		int32 URLId = INDEX_NONE;
+	};
+
+	// Only packages that use a URL with platform restrictions are listed
+	TMap<FName, FPackageEntry> RestrictedPackages;
+};
+
+#endif
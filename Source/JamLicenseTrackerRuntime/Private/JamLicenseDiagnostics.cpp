@@ -0,0 +1,240 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseDiagnostics.h"
+
+#include "JamLicenseBenchmark.h"
+#include "JamLicenseMemory.h"
+#include "JamLicenseRuntimeBenchmark.h"
+#include "JamLicenseTextSubsystem.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+FString FJamLicenseCacheCounter::ToString() const
+{
+	const int64 NumHits = Hits.load(std::memory_order_relaxed);
+	const int64 NumMisses = Misses.load(std::memory_order_relaxed);
+	const double HitRate = ((NumHits + NumMisses) > 0) ? (100.0 * (double)NumHits / (double)(NumHits + NumMisses)) : 0.0;
+	return FString::Printf(TEXT("%lld hits, %lld misses (%.1f%%)"), NumHits, NumMisses, HitRate);
+}
+
+namespace JamLicenseDiagnostics
+{
+	// Game thread only
+	static TArray<IJamLicenseDiagnostics*>& GetProviders()
+	{
+		static TArray<IJamLicenseDiagnostics*> Providers;
+		return Providers;
+	}
+
+	static void RunStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		for (IJamLicenseDiagnostics* Provider : GetProviders())
+		{
+			Ar.Logf(TEXT("[%s]"), Provider->GetDiagnosticsName());
+			Provider->PrintStats(Ar);
+		}
+	}
+
+	static void RunDump(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (Args.Num() == 0)
+		{
+			Ar.Logf(TEXT("Usage: JamLicense.Dump <url or url prefix>"));
+			return;
+		}
+
+		for (IJamLicenseDiagnostics* Provider : GetProviders())
+		{
+			Ar.Logf(TEXT("[%s]"), Provider->GetDiagnosticsName());
+			Provider->Dump(Args[0], Ar);
+		}
+	}
+
+	static void RunRebuild(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		for (IJamLicenseDiagnostics* Provider : GetProviders())
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Provider->Rebuild(Ar);
+			Ar.Logf(TEXT("[%s] rebuilt in %.2f ms"), Provider->GetDiagnosticsName(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+	}
+
+	static void RunBench(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FJamLicenseBenchmarkReport Report;
+		for (IJamLicenseDiagnostics* Provider : GetProviders())
+		{
+			Provider->Bench(Report, Ar);
+		}
+
+		for (const FJamLicenseBenchmarkResult& Result : Report.Results)
+		{
+			Ar.Logf(TEXT("%-24s n=%-5d p50=%9.3f ms  p99=%9.3f ms  max=%9.3f ms  %12.0f ops/s"),
+				*Result.Name, Result.NumSamples, Result.P50Ms, Result.P99Ms, Result.MaxMs, Result.GetOperationsPerSecond());
+		}
+
+		const FString Filename = FPaths::ProjectSavedDir() / TEXT("JamLicenseTracker") / TEXT("Benchmarks") / FString::Printf(TEXT("Console-%s.json"), *FDateTime::Now().ToString());
+		if (Report.SaveToFile(Filename))
+		{
+			Ar.Logf(TEXT("Wrote %s"), *Filename);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice StatsCommand(
+		TEXT("JamLicense.Stats"),
+		TEXT("Prints the size, build time and cache hit rates of the license tracking data"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunStats));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("JamLicense.Dump"),
+		TEXT("Prints everything known about the asset source URLs starting with the argument"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunDump));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice RebuildCommand(
+		TEXT("JamLicense.Rebuild"),
+		TEXT("Throws away and rebuilds the license tracking data"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunRebuild));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice BenchCommand(
+		TEXT("JamLicense.Bench"),
+		TEXT("Times the license tracking operations and writes a report to Saved/JamLicenseTracker/Benchmarks"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunBench));
+
+	// The manifest served by UJamLicenseTextSubsystem
+	class FRuntimeDiagnostics : public IJamLicenseDiagnostics
+	{
+	public:
+		FRuntimeDiagnostics()
+		{
+			Register(this);
+		}
+
+		//~IJamLicenseDiagnostics interface
+		virtual const TCHAR* GetDiagnosticsName() const override
+		{
+			return TEXT("Manifest");
+		}
+
+		virtual void PrintStats(FOutputDevice& Ar) const override
+		{
+			const UJamLicenseTextSubsystem* Subsystem = GetSubsystem();
+			if ((Subsystem == nullptr) || !Subsystem->HasManifest())
+			{
+				Ar.Logf(TEXT("  No license manifest loaded (looked for %s)"), *FJamLicenseManifest::GetStagedFilename());
+				return;
+			}
+
+			const FJamLicenseManifest& Manifest = Subsystem->GetManifest();
+			int32 NumPackages = 0;
+			for (const FJamLicenseManifestEntry& Entry : Manifest.Licenses)
+			{
+				NumPackages += Entry.Packages.Num();
+			}
+
+			FJamLicenseMemoryUsage Usage;
+			Manifest.GetMemoryUsage(/*inout*/ Usage);
+
+			Ar.Logf(TEXT("  File:            %s"), *Subsystem->GetManifestFilename());
+			Ar.Logf(TEXT("  Licenses:        %d (%d packages, %d cultures)"), Manifest.Licenses.Num(), NumPackages, Manifest.Cultures.Num());
+			Ar.Logf(TEXT("  Load time:       %.2f ms"), Subsystem->GetManifestLoadSeconds() * 1000.0);
+			Ar.Logf(TEXT("  Memory:          %.1f KB"), (double)Usage.GetTotal() / 1024.0);
+			Ar.Logf(TEXT("  Loaded culture:  %s (%d localized texts)"), *Subsystem->GetLoadedCulture(), Subsystem->GetNumLocalizedTexts());
+			Ar.Logf(TEXT("  Localized texts: %s"), *Subsystem->GetLocalizedTextCounter().ToString());
+		}
+
+		virtual void Dump(const FString& URLPrefix, FOutputDevice& Ar) const override
+		{
+			const UJamLicenseTextSubsystem* Subsystem = GetSubsystem();
+			if ((Subsystem == nullptr) || !Subsystem->HasManifest())
+			{
+				return;
+			}
+
+			for (const FJamLicenseManifestEntry& Entry : Subsystem->GetManifest().Licenses)
+			{
+				if (Entry.AssetSourceURL.StartsWith(URLPrefix))
+				{
+					FString Platforms;
+					for (FName Platform : Entry.AllowedPlatforms)
+					{
+						Platforms += (Platforms.IsEmpty() ? TEXT("") : TEXT(",")) + Platform.ToString();
+					}
+
+					Ar.Logf(TEXT("  %s"), *Entry.AssetSourceURL);
+					Ar.Logf(TEXT("    License: %s (%s), platforms: %s, text: %d chars"), Entry.LicenseAsset.IsEmpty() ? TEXT("none") : *Entry.LicenseAsset, *Entry.SPDXIdentifier, Platforms.IsEmpty() ? TEXT("all") : *Platforms, Entry.LicenseText.Len());
+					Ar.Logf(TEXT("    %d packages"), Entry.Packages.Num());
+					for (FName PackageName : Entry.Packages)
+					{
+						Ar.Logf(TEXT("      %s"), *PackageName.ToString());
+					}
+				}
+			}
+		}
+
+		virtual void Rebuild(FOutputDevice& Ar) override
+		{
+			if (UJamLicenseTextSubsystem* Subsystem = GetSubsystem())
+			{
+				Subsystem->ReloadManifest();
+			}
+		}
+
+		virtual void Bench(FJamLicenseBenchmarkReport& Report, FOutputDevice& Ar) override
+		{
+			const UJamLicenseTextSubsystem* Subsystem = GetSubsystem();
+
+			// Smaller than the benchmark game mode's defaults, so the console isn't frozen for long
+			FJamLicenseRuntimeBenchmark Benchmark;
+			Benchmark.ManifestFilename = ((Subsystem != nullptr) && Subsystem->HasManifest()) ? Subsystem->GetManifestFilename() : FString();
+			Benchmark.NumQueries = 500 * 1000;
+			Benchmark.NumLoadIterations = 3;
+
+			FString Error;
+			if (!Benchmark.Run(/*out*/ Report, /*out*/ Error))
+			{
+				Ar.Logf(TEXT("[%s] %s"), GetDiagnosticsName(), *Error);
+			}
+		}
+		//~End of IJamLicenseDiagnostics interface
+
+	private:
+		static UJamLicenseTextSubsystem* GetSubsystem()
+		{
+			return (GEngine != nullptr) ? GEngine->GetEngineSubsystem<UJamLicenseTextSubsystem>() : nullptr;
+		}
+	};
+
+	static FRuntimeDiagnostics RuntimeDiagnostics;
+}
+
+void IJamLicenseDiagnostics::Register(IJamLicenseDiagnostics* Provider)
+{
+	JamLicenseDiagnostics::GetProviders().AddUnique(Provider);
+}
+
+void IJamLicenseDiagnostics::Unregister(IJamLicenseDiagnostics* Provider)
+{
+	JamLicenseDiagnostics::GetProviders().Remove(Provider);
+}
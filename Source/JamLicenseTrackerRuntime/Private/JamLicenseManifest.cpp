@@ -0,0 +1,233 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseManifest.h"
+
+#include "JamLicenseMemory.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/IsSorted.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace JamLicenseManifest
+{
+	// Case is ignored to match how URLs are interned everywhere else, the case-sensitive tie break only keeps the
+	// order deterministic for manifests written before that (which could hold URLs that only differ in case)
+	static bool URLLess(const FString& A, const FString& B)
+	{
+		const int32 Result = A.Compare(B, ESearchCase::IgnoreCase);
+		return (Result != 0) ? (Result < 0) : (A.Compare(B, ESearchCase::CaseSensitive) < 0);
+	}
+
+	static bool EntryLess(const FJamLicenseManifestEntry& A, const FJamLicenseManifestEntry& B)
+	{
+		return URLLess(A.AssetSourceURL, B.AssetSourceURL);
+	}
+}
+
+FString FJamLicenseManifest::GetDefaultFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("JamLicenseTracker") / TEXT("LicenseManifest.json");
+}
+
+FString FJamLicenseManifest::GetStagedFilename()
+{
+	return FPaths::ProjectContentDir() / TEXT("JamLicenseTracker") / TEXT("LicenseManifest.json");
+}
+
+bool FJamLicenseManifest::LoadFromFile(const FString& Filename, FString& OutError)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(/*out*/ JsonText, *Filename))
+	{
+		OutError = FString::Printf(TEXT("Could not read %s"), *Filename);
+		return false;
+	}
+
+	FJamLicenseManifest Loaded;
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(JsonText, &Loaded))
+	{
+		OutError = FString::Printf(TEXT("%s is not a valid license manifest"), *Filename);
+		return false;
+	}
+
+	if (Loaded.FormatVersion > CurrentFormatVersion)
+	{
+		OutError = FString::Printf(TEXT("%s was written by a newer version of the plugin (format %d, expected %d or older)"), *Filename, Loaded.FormatVersion, CurrentFormatVersion);
+		return false;
+	}
+
+	// Older manifests were sorted case-sensitively
+	if (!Algo::IsSorted(Loaded.Licenses, &JamLicenseManifest::EntryLess))
+	{
+		Loaded.Licenses.Sort(&JamLicenseManifest::EntryLess);
+	}
+	Loaded.RebuildPackageLookup();
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
+
+bool FJamLicenseManifest::SaveToFile(const FString& Filename) const
+{
+	FString JsonText;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(*this, /*out*/ JsonText))
+	{
+		return false;
+	}
+
+	return FFileHelper::SaveStringToFile(JsonText, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+const FJamLicenseManifestEntry* FJamLicenseManifest::FindByURL(const FString& URL) const
+{
+	const int32 Index = Algo::LowerBoundBy(Licenses, URL, &FJamLicenseManifestEntry::AssetSourceURL, [](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::IgnoreCase) < 0; });
+	return Licenses.IsValidIndex(Index) && Licenses[Index].AssetSourceURL.Equals(URL, ESearchCase::IgnoreCase) ? &Licenses[Index] : nullptr;
+}
+
+void FJamLicenseManifest::Normalize()
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	Licenses.Sort(&JamLicenseManifest::EntryLess);
+
+	for (FJamLicenseManifestEntry& Entry : Licenses)
+	{
+		Entry.Packages.Sort(FNameLexicalLess());
+		Entry.AllowedPlatforms.Sort(FNameLexicalLess());
+	}
+
+	Cultures.Sort();
+
+	RebuildPackageLookup();
+}
+
+const FJamLicenseManifestEntry* FJamLicenseManifest::FindByPackage(FName PackageName) const
+{
+	const int32* pIndex = PackageToLicense.Find(PackageName);
+	return (pIndex != nullptr) ? &Licenses[*pIndex] : nullptr;
+}
+
+void FJamLicenseManifest::FindAllByPackage(FName PackageName, TArray<const FJamLicenseManifestEntry*>& OutEntries) const
+{
+	if (const FJamLicenseManifestEntry* FirstEntry = FindByPackage(PackageName))
+	{
+		OutEntries.Add(FirstEntry);
+
+		TArray<int32, TInlineAllocator<4>> AdditionalIndices;
+		PackageToAdditionalLicenses.MultiFind(PackageName, /*out*/ AdditionalIndices, /*bMaintainOrder=*/ true);
+		for (int32 Index : AdditionalIndices)
+		{
+			OutEntries.Add(&Licenses[Index]);
+		}
+	}
+}
+
+void FJamLicenseManifest::RebuildPackageLookup()
+{
+	int32 NumPackages = 0;
+	for (const FJamLicenseManifestEntry& Entry : Licenses)
+	{
+		NumPackages += Entry.Packages.Num();
+	}
+
+	PackageToLicense.Reset();
+	PackageToLicense.Reserve(NumPackages);
+	PackageToAdditionalLicenses.Reset();
+	for (int32 Index = 0; Index < Licenses.Num(); ++Index)
+	{
+		for (FName PackageName : Licenses[Index].Packages)
+		{
+			int32& FirstIndex = PackageToLicense.FindOrAdd(PackageName, INDEX_NONE);
+			if (FirstIndex == INDEX_NONE)
+			{
+				FirstIndex = Index;
+			}
+			else
+			{
+				PackageToAdditionalLicenses.Add(PackageName, Index);
+			}
+		}
+	}
+}
+
+SIZE_T FJamLicenseManifest::GetAllocatedSize() const
+{
+	FJamLicenseMemoryUsage Usage;
+	GetMemoryUsage(/*inout*/ Usage);
+	return Usage.GetTotal();
+}
+
+void FJamLicenseManifest::GetMemoryUsage(FJamLicenseMemoryUsage& InOutUsage) const
+{
+	InOutUsage.IndexTables += Licenses.GetAllocatedSize() + Cultures.GetAllocatedSize() + PackageToLicense.GetAllocatedSize() + PackageToAdditionalLicenses.GetAllocatedSize();
+	for (const FJamLicenseManifestEntry& Entry : Licenses)
+	{
+		InOutUsage.IndexTables += Entry.AllowedPlatforms.GetAllocatedSize() + Entry.Packages.GetAllocatedSize();
+		InOutUsage.StringPools += Entry.AssetSourceURL.GetAllocatedSize() + Entry.LicenseAsset.GetAllocatedSize() + Entry.SPDXIdentifier.GetAllocatedSize();
+		InOutUsage.LicenseBodies += Entry.LicenseText.GetAllocatedSize();
+	}
+	for (const FString& Culture : Cultures)
+	{
+		InOutUsage.StringPools += Culture.GetAllocatedSize();
+	}
+}
+
+FString FJamLicenseManifestCultureSection::GetFilename(const FString& ManifestFilename, const FString& Culture)
+{
+	return FPaths::GetPath(ManifestFilename) / FString::Printf(TEXT("%s.%s.json"), *FPaths::GetBaseFilename(ManifestFilename), *Culture);
+}
+
+bool FJamLicenseManifestCultureSection::LoadFromFile(const FString& Filename, FString& OutError)
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(/*out*/ JsonText, *Filename))
+	{
+		OutError = FString::Printf(TEXT("Could not read %s"), *Filename);
+		return false;
+	}
+
+	FJamLicenseManifestCultureSection Loaded;
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(JsonText, &Loaded))
+	{
+		OutError = FString::Printf(TEXT("%s is not a valid license manifest culture section"), *Filename);
+		return false;
+	}
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
+
+bool FJamLicenseManifestCultureSection::SaveToFile(const FString& Filename) const
+{
+	FString JsonText;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(*this, /*out*/ JsonText))
+	{
+		return false;
+	}
+
+	return FFileHelper::SaveStringToFile(JsonText, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
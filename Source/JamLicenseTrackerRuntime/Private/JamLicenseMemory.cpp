@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseMemory.h"
+
+#include "HAL/IConsoleManager.h"
+
+LLM_DEFINE_TAG(JamLicenseTracker);
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GJamLicenseMemReportCommand(
+	TEXT("JamLicense.MemReport"),
+	TEXT("Prints the memory used by license tracking data, split into index tables, string pools, license bodies and caches"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FJamLicenseMemoryReport::Gather().Print(Ar);
+	}));
+
+FJamLicenseMemoryReport::FOnGather& FJamLicenseMemoryReport::OnGather()
+{
+	static FOnGather Delegate;
+	return Delegate;
+}
+
+FJamLicenseMemoryReport FJamLicenseMemoryReport::Gather()
+{
+	FJamLicenseMemoryReport Report;
+	OnGather().Broadcast(Report);
+	return Report;
+}
+
+void FJamLicenseMemoryReport::Add(const FString& Owner, const FJamLicenseMemoryUsage& Usage)
+{
+	Entries.Emplace(Owner, Usage);
+}
+
+void FJamLicenseMemoryReport::Print(FOutputDevice& Ar) const
+{
+	auto ToKB = [](SIZE_T Bytes) { return (double)Bytes / 1024.0; };
+
+	Ar.Logf(TEXT("JamLicenseTracker memory (KB):"));
+	Ar.Logf(TEXT("%-32s %12s %12s %12s %12s %12s"), TEXT("Owner"), TEXT("IndexTables"), TEXT("StringPools"), TEXT("LicenseBodies"), TEXT("Caches"), TEXT("Total"));
+
+	FJamLicenseMemoryUsage Total;
+	for (const TPair<FString, FJamLicenseMemoryUsage>& Entry : Entries)
+	{
+		const FJamLicenseMemoryUsage& Usage = Entry.Value;
+		Ar.Logf(TEXT("%-32s %12.1f %12.1f %12.1f %12.1f %12.1f"), *Entry.Key, ToKB(Usage.IndexTables), ToKB(Usage.StringPools), ToKB(Usage.LicenseBodies), ToKB(Usage.Caches), ToKB(Usage.GetTotal()));
+		Total += Usage;
+	}
+
+	Ar.Logf(TEXT("%-32s %12.1f %12.1f %12.1f %12.1f %12.1f"), TEXT("Total"), ToKB(Total.IndexTables), ToKB(Total.StringPools), ToKB(Total.LicenseBodies), ToKB(Total.Caches), ToKB(Total.GetTotal()));
+}
@@ -0,0 +1,231 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseRuntimeBenchmark.h"
+
+#include "JamLicenseManifest.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+
+namespace JamLicenseRuntimeBenchmark
+{
+	// Point queries are timed in batches, since a single lookup is too quick to time on its own
+	constexpr int32 QueriesPerBatch = 256;
+
+	// Mix of query types, in percent of batches (enumerating everything is far more expensive than a lookup, so it's rare)
+	constexpr int32 EnumeratePercent = 1;
+	constexpr int32 ByURLPercent = 50;
+
+	// Fraction of queries that ask for something that isn't in the manifest, in percent
+	constexpr int32 MissPercent = 10;
+
+	// Caps the number of distinct packages queried, so the query pool doesn't dwarf the manifest being measured
+	constexpr int32 MaxPackagePoolSize = 64 * 1024;
+
+	struct FThreadSamples
+	{
+		TArray<double> ByURL;
+		TArray<double> ByPackage;
+		TArray<double> EnumerateAll;
+		int64 NumFound = 0;
+		int64 NumEnumerated = 0;
+	};
+
+	FJamLicenseBenchmarkResult MakeResult(const TCHAR* Name, TArray<double>&& SamplesMs, int64 OperationsPerSample)
+	{
+		FJamLicenseBenchmarkResult Result;
+		Result.Name = Name;
+		Result.OperationsPerSample = OperationsPerSample;
+		Result.SamplesMs = MoveTemp(SamplesMs);
+		Result.Finalize();
+		return Result;
+	}
+}
+
+bool FJamLicenseRuntimeBenchmark::Run(FJamLicenseBenchmarkReport& OutReport, FString& OutError) const
+{
+	using namespace JamLicenseRuntimeBenchmark;
+
+	FString Filename = ManifestFilename;
+	if (Filename.IsEmpty())
+	{
+		Filename = FJamLicenseManifest::GetStagedFilename();
+		if (!IFileManager::Get().FileExists(*Filename))
+		{
+			Filename = FJamLicenseManifest::GetDefaultFilename();
+		}
+	}
+
+	// The first load in this process (the OS may still have the file cached, e.g. if the text subsystem read it at startup)
+	FJamLicenseManifest Manifest;
+	const uint64 UsedPhysicalBeforeLoad = FPlatformMemory::GetStats().UsedPhysical;
+	const double ColdStartTime = FPlatformTime::Seconds();
+	if (!Manifest.LoadFromFile(Filename, /*out*/ OutError))
+	{
+		return false;
+	}
+	TArray<double> ColdSamples = { (FPlatformTime::Seconds() - ColdStartTime) * 1000.0 };
+	const int64 UsedPhysicalDelta = (int64)FPlatformMemory::GetStats().UsedPhysical - (int64)UsedPhysicalBeforeLoad;
+
+	FJamLicenseBenchmarkResult& ColdResult = OutReport.Results.Add_GetRef(MakeResult(TEXT("ManifestLoadCold"), MoveTemp(ColdSamples), 1));
+	ColdResult.MemoryGrowthBytes = (uint64)FMath::Max<int64>(UsedPhysicalDelta, 0);
+
+	OutReport.Results.Add(FJamLicenseBenchmarkResult::Run(TEXT("ManifestLoadWarm"), FMath::Max(NumLoadIterations, 1), [&Filename](int32)
+	{
+		FJamLicenseManifest Loaded;
+		FString Error;
+		Loaded.LoadFromFile(Filename, /*out*/ Error);
+	}));
+
+	// Build the query pools up front, including some misses
+	FRandomStream PoolRandom(1);
+
+	TArray<FString> URLPool;
+	for (const FJamLicenseManifestEntry& Entry : Manifest.Licenses)
+	{
+		URLPool.Add(Entry.AssetSourceURL);
+	}
+
+	TArray<FName> PackagePool;
+	for (const FJamLicenseManifestEntry& Entry : Manifest.Licenses)
+	{
+		PackagePool.Append(Entry.Packages);
+	}
+	while (PackagePool.Num() > MaxPackagePoolSize)
+	{
+		PackagePool.RemoveAtSwap(PoolRandom.RandHelper(PackagePool.Num()), 1, /*bAllowShrinking=*/ false);
+	}
+
+	const int32 NumURLMisses = FMath::Max(URLPool.Num() * MissPercent / 100, 1);
+	for (int32 MissIndex = 0; MissIndex < NumURLMisses; ++MissIndex)
+	{
+		URLPool.Add(FString::Printf(TEXT("https://example.invalid/missing/%d"), MissIndex));
+	}
+
+	const int32 NumPackageMisses = FMath::Max(PackagePool.Num() * MissPercent / 100, 1);
+	for (int32 MissIndex = 0; MissIndex < NumPackageMisses; ++MissIndex)
+	{
+		PackagePool.Add(FName(*FString::Printf(TEXT("/Game/Missing/Package_%d"), MissIndex)));
+	}
+
+	const int32 NumQueryThreads = (NumThreads > 0) ? NumThreads : FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+	const int64 QueriesPerThread = FMath::Max<int64>(NumQueries / NumQueryThreads, QueriesPerBatch);
+
+	TArray<FThreadSamples> ThreadSamples;
+	ThreadSamples.SetNum(NumQueryThreads);
+
+	const double QueryStartTime = FPlatformTime::Seconds();
+	ParallelFor(NumQueryThreads, [&](int32 ThreadIndex)
+	{
+		FThreadSamples& Samples = ThreadSamples[ThreadIndex];
+		const int64 NumBatches = QueriesPerThread / QueriesPerBatch;
+		Samples.ByURL.Reserve(NumBatches);
+		Samples.ByPackage.Reserve(NumBatches);
+
+		FRandomStream Random(ThreadIndex + 1);
+		int32 BatchIndices[QueriesPerBatch];
+
+		int64 NumIssued = 0;
+		while (NumIssued < QueriesPerThread)
+		{
+			const int32 Roll = Random.RandHelper(100);
+			if (Roll < EnumeratePercent)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				for (const FJamLicenseManifestEntry& Entry : Manifest.Licenses)
+				{
+					Samples.NumEnumerated += Entry.Packages.Num();
+				}
+				Samples.EnumerateAll.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+				NumIssued += 1;
+			}
+			else if (Roll < EnumeratePercent + ByURLPercent)
+			{
+				for (int32& Index : BatchIndices)
+				{
+					Index = Random.RandHelper(URLPool.Num());
+				}
+
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Index : BatchIndices)
+				{
+					Samples.NumFound += (Manifest.FindByURL(URLPool[Index]) != nullptr) ? 1 : 0;
+				}
+				Samples.ByURL.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+				NumIssued += QueriesPerBatch;
+			}
+			else
+			{
+				for (int32& Index : BatchIndices)
+				{
+					Index = Random.RandHelper(PackagePool.Num());
+				}
+
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Index : BatchIndices)
+				{
+					Samples.NumFound += (Manifest.FindByPackage(PackagePool[Index]) != nullptr) ? 1 : 0;
+				}
+				Samples.ByPackage.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+				NumIssued += QueriesPerBatch;
+			}
+		}
+	});
+	const double QueryWallSeconds = FPlatformTime::Seconds() - QueryStartTime;
+
+	TArray<double> ByURLSamples;
+	TArray<double> ByPackageSamples;
+	TArray<double> EnumerateAllSamples;
+	int64 NumFound = 0;
+	int64 NumIssued = 0;
+	for (FThreadSamples& Samples : ThreadSamples)
+	{
+		NumIssued += (Samples.ByURL.Num() + Samples.ByPackage.Num()) * (int64)QueriesPerBatch + Samples.EnumerateAll.Num();
+		ByURLSamples.Append(MoveTemp(Samples.ByURL));
+		ByPackageSamples.Append(MoveTemp(Samples.ByPackage));
+		EnumerateAllSamples.Append(MoveTemp(Samples.EnumerateAll));
+		NumFound += Samples.NumFound;
+	}
+
+	OutReport.Results.Add(MakeResult(TEXT("QueryByURL"), MoveTemp(ByURLSamples), QueriesPerBatch));
+	OutReport.Results.Add(MakeResult(TEXT("QueryByPackage"), MoveTemp(ByPackageSamples), QueriesPerBatch));
+	OutReport.Results.Add(MakeResult(TEXT("EnumerateAll"), MoveTemp(EnumerateAllSamples), 1));
+
+	OutReport.Context.Add(TEXT("manifest"), Filename);
+	OutReport.Context.Add(TEXT("platform"), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+	OutReport.Context.Add(TEXT("configuration"), LexToString(FApp::GetBuildConfiguration()));
+	OutReport.Context.Add(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	OutReport.Context.Add(TEXT("threads"), LexToString(NumQueryThreads));
+	OutReport.Context.Add(TEXT("licenses"), LexToString(Manifest.Licenses.Num()));
+	OutReport.Context.Add(TEXT("queries"), LexToString(NumIssued));
+	OutReport.Context.Add(TEXT("queryHits"), LexToString(NumFound));
+	OutReport.Context.Add(TEXT("mixedQueriesPerSecond"), FString::Printf(TEXT("%.0f"), (QueryWallSeconds > 0.0) ? (double)NumIssued / QueryWallSeconds : 0.0));
+	OutReport.Context.Add(TEXT("manifestFileBytes"), LexToString(IFileManager::Get().FileSize(*Filename)));
+	OutReport.Context.Add(TEXT("manifestAllocatedBytes"), LexToString((uint64)Manifest.GetAllocatedSize()));
+	OutReport.Context.Add(TEXT("manifestLoadUsedPhysicalDelta"), LexToString(UsedPhysicalDelta));
+	OutReport.AddPeakMemoryToContext();
+
+	return true;
+}
@@ -0,0 +1,195 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "JamLicenseTextSubsystem.h"
+
+#include "JamLicenseMemory.h"
+#include "JamLicenseTrackerLog.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Internationalization/Culture.h"
+#include "Internationalization/Internationalization.h"
+
+void UJamLicenseTextSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ManifestFilename = FJamLicenseManifest::GetStagedFilename();
+	FInternationalization::Get().OnCultureChanged().AddUObject(this, &ThisClass::OnCultureChanged);
+	ReloadManifest();
+
+	MemoryReportHandle = FJamLicenseMemoryReport::OnGather().AddUObject(this, &ThisClass::GatherMemoryUsage);
+}
+
+void UJamLicenseTextSubsystem::Deinitialize()
+{
+	if (FInternationalization::IsAvailable())
+	{
+		FInternationalization::Get().OnCultureChanged().RemoveAll(this);
+	}
+
+	FJamLicenseMemoryReport::OnGather().Remove(MemoryReportHandle);
+
+	// Drop any load still in flight
+	++LoadSerial;
+
+	Super::Deinitialize();
+}
+
+void UJamLicenseTextSubsystem::ReloadManifest()
+{
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	// Drop any culture load still in flight, it was for the old manifest
+	++LoadSerial;
+
+	const bool bHadManifest = bHasManifest;
+	Manifest = FJamLicenseManifest();
+	LocalizedText.Reset();
+	LoadedCulture.Reset();
+	bHasManifest = false;
+
+	const double StartTime = FPlatformTime::Seconds();
+	if (IFileManager::Get().FileExists(*ManifestFilename))
+	{
+		FString Error;
+		bHasManifest = Manifest.LoadFromFile(ManifestFilename, /*out*/ Error);
+		if (!bHasManifest)
+		{
+			UE_LOG(LogJamLicenseTracker, Warning, TEXT("%s"), *Error);
+		}
+	}
+	ManifestLoadSeconds = FPlatformTime::Seconds() - StartTime;
+
+	if (bHasManifest)
+	{
+		OnCultureChanged();
+	}
+
+	if (bHadManifest || bHasManifest)
+	{
+		OnLicenseTextChanged.Broadcast();
+	}
+}
+
+FString UJamLicenseTextSubsystem::GetLicenseText(const FString& AssetSourceURL) const
+{
+	const FString* pLocalized = LocalizedText.Find(AssetSourceURL);
+	LocalizedTextCounter.Record(pLocalized != nullptr);
+	if (pLocalized != nullptr)
+	{
+		return *pLocalized;
+	}
+
+	const FJamLicenseManifestEntry* Entry = Manifest.FindByURL(AssetSourceURL);
+	return (Entry != nullptr) ? Entry->LicenseText : FString();
+}
+
+void UJamLicenseTextSubsystem::GatherMemoryUsage(FJamLicenseMemoryReport& Report) const
+{
+	FJamLicenseMemoryUsage Usage;
+	Manifest.GetMemoryUsage(/*inout*/ Usage);
+
+	Usage.IndexTables += LocalizedText.GetAllocatedSize();
+	for (const TPair<FString, FString>& Pair : LocalizedText)
+	{
+		Usage.StringPools += Pair.Key.GetAllocatedSize();
+		Usage.LicenseBodies += Pair.Value.GetAllocatedSize();
+	}
+
+	Report.Add(TEXT("TextSubsystem"), Usage);
+}
+
+void UJamLicenseTextSubsystem::OnCultureChanged()
+{
+	if (!bHasManifest)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+	RequestCulture(FInternationalization::Get().GetCurrentLanguage()->GetName());
+}
+
+void UJamLicenseTextSubsystem::RequestCulture(const FString& CultureName)
+{
+	if ((CultureName == LoadedCulture) && (LocalizedText.Num() > 0))
+	{
+		return;
+	}
+
+	// Most specific first (e.g., pt-BR then pt), only for cultures the manifest actually has sections for
+	TArray<FString> SectionFilenames;
+	for (const FString& PrioritizedName : FInternationalization::Get().GetPrioritizedCultureNames(CultureName))
+	{
+		if (Manifest.Cultures.Contains(PrioritizedName))
+		{
+			SectionFilenames.Add(FJamLicenseManifestCultureSection::GetFilename(ManifestFilename, PrioritizedName));
+		}
+	}
+
+	const uint32 Serial = ++LoadSerial;
+	if (SectionFilenames.Num() == 0)
+	{
+		const bool bHadLocalizedText = LocalizedText.Num() > 0;
+		LocalizedText.Reset();
+		LoadedCulture = CultureName;
+		if (bHadLocalizedText)
+		{
+			OnLicenseTextChanged.Broadcast();
+		}
+		return;
+	}
+
+	TWeakObjectPtr<ThisClass> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, CultureName, SectionFilenames = MoveTemp(SectionFilenames)]()
+	{
+		LLM_SCOPE_BYTAG(JamLicenseTracker);
+
+		// Least specific first, so more specific cultures overwrite their parents
+		TMap<FString, FString> Merged;
+		for (int32 Index = SectionFilenames.Num() - 1; Index >= 0; --Index)
+		{
+			FJamLicenseManifestCultureSection Section;
+			FString Error;
+			if (Section.LoadFromFile(SectionFilenames[Index], /*out*/ Error))
+			{
+				Merged.Append(MoveTemp(Section.LicenseTextByURL));
+			}
+			else
+			{
+				UE_LOG(LogJamLicenseTracker, Warning, TEXT("%s"), *Error);
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, CultureName, Merged = MoveTemp(Merged)]() mutable
+		{
+			ThisClass* This = WeakThis.Get();
+			if ((This != nullptr) && (This->LoadSerial == Serial))
+			{
+				This->LocalizedText = MoveTemp(Merged);
+				This->LoadedCulture = CultureName;
+				This->OnLicenseTextChanged.Broadcast();
+			}
+		});
+	});
+}
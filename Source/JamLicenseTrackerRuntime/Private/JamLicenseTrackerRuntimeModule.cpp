@@ -19,5 +19,8 @@
 */
 
 #include "Modules/ModuleManager.h"
+#include "JamLicenseTrackerLog.h"
+
+DEFINE_LOG_CATEGORY(LogJamLicenseTracker);
 
 IMPLEMENT_MODULE(FDefaultModuleImpl, JamLicenseTrackerRuntime)
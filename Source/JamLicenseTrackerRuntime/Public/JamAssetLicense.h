@@ -35,7 +35,23 @@ public:
 	UPROPERTY(EditAnywhere, AssetRegistrySearchable, DuplicateTransient, BlueprintReadOnly)
 	FString AssetSourceURL;
 
+	// The SPDX identifier of the license, if it has one (e.g., CC-BY-4.0, see https://spdx.org/licenses/)
+	UPROPERTY(EditAnywhere, AssetRegistrySearchable, BlueprintReadOnly)
+	FString SPDXIdentifier;
+
+	// The platforms (by ini platform name, e.g., Windows or Android) that assets covered by this license may ship on, or empty if there are no restrictions
+	// This is only enforced when the project uses UJamLicenseAssetManager (or a subclass) as its asset manager
+	UPROPERTY(EditAnywhere, AssetRegistrySearchable, BlueprintReadOnly)
+	TArray<FName> AllowedPlatforms;
+
 	// The license the associated assets are used under
 	UPROPERTY(EditAnywhere, meta=(MultiLine=true), BlueprintReadOnly)
 	FString LicenseText;
+
+#if WITH_EDITORONLY_DATA
+	// Localized variants of LicenseText, keyed by culture name (e.g., fr or pt-BR), for vendors that require localized attribution
+	// These are harvested into per-culture sections of the license manifest, so at runtime only the active culture is ever loaded
+	UPROPERTY(EditAnywhere, meta=(MultiLine=true))
+	TMap<FString, FString> LocalizedLicenseText;
+#endif
 };
@@ -0,0 +1,51 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Engine/AssetManager.h"
+
+#include "JamLicenseAssetManager.generated.h"
+
+// Asset manager that keeps packages out of cooks for platforms their license doesn't allow (see UJamAssetLicense::AllowedPlatforms)
+//
+// To use it, set AssetManagerClassName=/Script/JamLicenseTrackerRuntime.JamLicenseAssetManager in the [/Script/Engine.Engine]
+// section of DefaultEngine.ini, or derive your own asset manager from it
+UCLASS(config=Game)
+class JAMLICENSETRACKERRUNTIME_API UJamLicenseAssetManager : public UAssetManager
+{
+	GENERATED_BODY()
+
+public:
+	// Should the cook fail (with an error per package) when a package's license excludes the target platform?
+	// Otherwise such packages are silently left out of the cook
+	UPROPERTY(config)
+	bool bErrorOnDisallowedPlatformLicense = false;
+
+#if WITH_EDITOR
+	// Broadcast once, before the cook filter first reads the license tags from the asset registry, so the editor module can add
+	// any tags the registry is missing first (see FJamLicenseTagBackfill)
+	static FSimpleMulticastDelegate OnPreBuildCookFilter;
+
+	//~UAssetManager interface
+	virtual bool ShouldCookForPlatform(const UPackage* Package, const ITargetPlatform* TargetPlatform) override;
+	//~End of UAssetManager interface
+#endif
+};
@@ -0,0 +1,88 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+// Timings of one benchmarked license operation
+struct JAMLICENSETRACKERRUNTIME_API FJamLicenseBenchmarkResult
+{
+	FString Name;
+
+	// How many operations each sample covers (for throughput), e.g. the number of queries in a batch
+	int64 OperationsPerSample = 1;
+
+	// Raw samples, only present for results measured in this process
+	TArray<double> SamplesMs;
+
+	// Summary of the samples (filled in by Finalize, or loaded from a report)
+	int32 NumSamples = 0;
+	double MinMs = 0.0;
+	double MeanMs = 0.0;
+	double P50Ms = 0.0;
+	double P90Ms = 0.0;
+	double P99Ms = 0.0;
+	double MaxMs = 0.0;
+
+	// How far physical memory use rose above where it was when the benchmark started, sampled after every call
+	// (so memory freed again within a call isn't seen). Run measures this, results built from raw samples leave it to the caller (0 if unmeasured)
+	uint64 MemoryGrowthBytes = 0;
+
+	// Runs Body NumIterations times (after one untimed warm-up call), timing each call
+	static FJamLicenseBenchmarkResult Run(const FString& Name, int32 NumIterations, TFunctionRef<void(int32 Iteration)> Body, int64 OperationsPerSample = 1);
+
+	// Computes the summary from the samples
+	void Finalize();
+
+	double GetOperationsPerSecond() const
+	{
+		return (MeanMs > 0.0) ? ((double)OperationsPerSample * 1000.0 / MeanMs) : 0.0;
+	}
+
+	TSharedRef<FJsonObject> ToJson() const;
+	static FJamLicenseBenchmarkResult FromJson(const FJsonObject& Object);
+};
+
+// A set of benchmark results, saved as JSON so runs can be compared against a baseline
+struct JAMLICENSETRACKERRUNTIME_API FJamLicenseBenchmarkReport
+{
+	// Free-form description of what was measured (e.g., the content size), recorded alongside the results
+	TMap<FString, FString> Context;
+
+	// Records the process-wide peak physical memory use in Context, once every benchmark has run
+	void AddPeakMemoryToContext();
+
+	TArray<FJamLicenseBenchmarkResult> Results;
+
+	bool SaveToFile(const FString& Filename) const;
+	bool LoadFromFile(const FString& Filename, FString& OutError);
+
+	const FJamLicenseBenchmarkResult* FindResult(const FString& Name) const;
+
+	// Returns a description of every benchmark whose median time or memory growth rose by more than Threshold
+	// (e.g., 0.2 for 20%) compared to the baseline. Benchmarks missing from either report are skipped
+	TArray<FString> FindRegressions(const FJamLicenseBenchmarkReport& Baseline, double Threshold) const;
+
+	// Logs a one-line summary per result
+	void LogSummary() const;
+};
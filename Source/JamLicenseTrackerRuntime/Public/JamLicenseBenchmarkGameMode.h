@@ -0,0 +1,60 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "GameFramework/GameModeBase.h"
+#include "JamLicenseRuntimeBenchmark.h"
+
+#include "JamLicenseBenchmarkGameMode.generated.h"
+
+// Runs FJamLicenseRuntimeBenchmark when play starts, writes the report, and quits
+//
+// Launch a cooked build on the target hardware with any map, e.g.:
+//   MyGame.exe /Game/Maps/Empty?game=/Script/JamLicenseTrackerRuntime.JamLicenseBenchmarkGameMode -nullrhi -nosound -unattended
+//
+// URL options:
+//   ?Threads=N ?Queries=N ?LoadIterations=N ?Manifest=<file>   See FJamLicenseRuntimeBenchmark
+//   ?Output=<file>      Where to write the report (defaults to Saved/JamLicenseTracker/Benchmarks)
+//   ?Baseline=<file>    Report to compare against; the process exits with 1 if anything regressed by more than ?Threshold= (0.2)
+//   ?NoExit             Stay running once the benchmark has finished
+UCLASS()
+class JAMLICENSETRACKERRUNTIME_API AJamLicenseBenchmarkGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+public:
+	AJamLicenseBenchmarkGameMode();
+
+	//~AGameModeBase interface
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+	virtual void StartPlay() override;
+	//~End of AGameModeBase interface
+
+private:
+	void OnBenchmarkFinished(bool bSuccess, const FJamLicenseBenchmarkReport& Report, const FString& Error);
+
+private:
+	FJamLicenseRuntimeBenchmark Benchmark;
+	FString OutputFilename;
+	FString BaselineFilename;
+	double Threshold = 0.2;
+	bool bExitWhenDone = true;
+};
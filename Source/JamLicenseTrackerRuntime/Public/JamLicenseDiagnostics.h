@@ -0,0 +1,66 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+struct FJamLicenseBenchmarkReport;
+
+// Hit/miss counts of a cache, for JamLicense.Stats (safe to record from any thread)
+struct JAMLICENSETRACKERRUNTIME_API FJamLicenseCacheCounter
+{
+	std::atomic<int64> Hits{0};
+	std::atomic<int64> Misses{0};
+
+	void Record(bool bHit)
+	{
+		(bHit ? Hits : Misses).fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// e.g., "120 hits, 30 misses (80.0%)"
+	FString ToString() const;
+};
+
+// Something in the plugin that can be inspected through the JamLicense.* console commands:
+//   JamLicense.Stats                 Sizes, build times and cache hit rates
+//   JamLicense.Dump <url|prefix>     Everything known about the URLs starting with the prefix
+//   JamLicense.Rebuild               Throws away and rebuilds the tables
+//   JamLicense.Bench                 Times each operation and writes a report to Saved/JamLicenseTracker/Benchmarks
+//
+// The runtime module registers the manifest served by UJamLicenseTextSubsystem, and the editor module registers the license index
+class JAMLICENSETRACKERRUNTIME_API IJamLicenseDiagnostics
+{
+public:
+	virtual ~IJamLicenseDiagnostics() {}
+
+	// Heading for this provider's part of the output
+	virtual const TCHAR* GetDiagnosticsName() const = 0;
+
+	virtual void PrintStats(FOutputDevice& Ar) const = 0;
+	virtual void Dump(const FString& URLPrefix, FOutputDevice& Ar) const = 0;
+	virtual void Rebuild(FOutputDevice& Ar) = 0;
+	virtual void Bench(FJamLicenseBenchmarkReport& Report, FOutputDevice& Ar) = 0;
+
+	static void Register(IJamLicenseDiagnostics* Provider);
+	static void Unregister(IJamLicenseDiagnostics* Provider);
+};
@@ -0,0 +1,139 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "JamLicenseManifest.generated.h"
+
+struct FJamLicenseMemoryUsage;
+
+// Everything that shipped under one asset source URL
+USTRUCT()
+struct JAMLICENSETRACKERRUNTIME_API FJamLicenseManifestEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString AssetSourceURL;
+
+	// Object path of the UJamAssetLicense covering the URL, or empty if the URL is unlicensed
+	UPROPERTY()
+	FString LicenseAsset;
+
+	UPROPERTY()
+	FString SPDXIdentifier;
+
+	// Empty if the license has no platform restrictions
+	UPROPERTY()
+	TArray<FName> AllowedPlatforms;
+
+	// License text in the default language (localized variants are kept in per-culture sections, see FJamLicenseManifestCultureSection)
+	UPROPERTY()
+	FString LicenseText;
+
+	// Long package names of every package with an asset using the URL
+	UPROPERTY()
+	TArray<FName> Packages;
+};
+
+// The localized license texts for one culture, stored next to the manifest (e.g., LicenseManifest.fr.json) so
+// only the cultures that are actually used ever get loaded
+USTRUCT()
+struct JAMLICENSETRACKERRUNTIME_API FJamLicenseManifestCultureSection
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Culture;
+
+	// Asset source URL -> license text in this culture
+	UPROPERTY()
+	TMap<FString, FString> LicenseTextByURL;
+
+public:
+	// Returns the filename of the section for a culture, given the filename of the manifest
+	static FString GetFilename(const FString& ManifestFilename, const FString& Culture);
+
+	bool LoadFromFile(const FString& Filename, FString& OutError);
+	bool SaveToFile(const FString& Filename) const;
+};
+
+// A snapshot of which packages are used under which license, harvested from the asset registry by the
+// JamLicenseHarvest commandlet, and checked against cooked output by the JamLicenseVerifyContainers commandlet
+USTRUCT()
+struct JAMLICENSETRACKERRUNTIME_API FJamLicenseManifest
+{
+	GENERATED_BODY()
+
+	static constexpr int32 CurrentFormatVersion = 2;
+
+	UPROPERTY()
+	int32 FormatVersion = CurrentFormatVersion;
+
+	// Sorted by URL, ignoring case (URLs that only differ in case are one source everywhere in the plugin, the
+	// harvester keeps the first spelling it sees)
+	UPROPERTY()
+	TArray<FJamLicenseManifestEntry> Licenses;
+
+	// Cultures that have a section with localized license texts
+	UPROPERTY()
+	TArray<FString> Cultures;
+
+public:
+	// Returns the default location manifests are harvested to
+	static FString GetDefaultFilename();
+
+	// Returns the location the runtime loads the manifest from (harvest with -Stage to write it there, and add
+	// the JamLicenseTracker content folder to DirectoriesToAlwaysStageAsUFS so it gets packaged)
+	static FString GetStagedFilename();
+
+	bool LoadFromFile(const FString& Filename, FString& OutError);
+	bool SaveToFile(const FString& Filename) const;
+
+	// Returns the entry for the URL (compared ignoring case), or nullptr if it isn't in the manifest
+	const FJamLicenseManifestEntry* FindByURL(const FString& URL) const;
+
+	// Returns the entry whose URL the package was shipped under, or nullptr if the package isn't in the manifest.
+	// A package holding assets from several sources is listed under each of their URLs, in which case this returns
+	// the first of those entries in manifest order (use FindAllByPackage to get every one)
+	const FJamLicenseManifestEntry* FindByPackage(FName PackageName) const;
+
+	// Appends every entry that lists the package, in manifest order
+	void FindAllByPackage(FName PackageName, TArray<const FJamLicenseManifestEntry*>& OutEntries) const;
+
+	// Sorts the entries and their package lists, so harvesting the same content always produces the same file
+	void Normalize();
+
+	// Returns the heap memory used by the entries and lookups
+	SIZE_T GetAllocatedSize() const;
+	void GetMemoryUsage(FJamLicenseMemoryUsage& InOutUsage) const;
+
+private:
+	void RebuildPackageLookup();
+
+private:
+	// Package name -> index of the first entry in Licenses that lists it (rebuilt on load and normalize rather than serialized)
+	TMap<FName, int32> PackageToLicense;
+
+	// Package name -> indices of any later entries that also list it (rare, so kept out of the main lookup)
+	TMultiMap<FName, int32> PackageToAdditionalLicenses;
+};
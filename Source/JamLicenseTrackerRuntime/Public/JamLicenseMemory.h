@@ -0,0 +1,80 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// LLM tag for every allocation made by the plugin (editor and runtime), so license data shows up as its own
+// line in LLM reports instead of being folded into whichever system happened to call into us
+LLM_DECLARE_TAG_API(JamLicenseTracker, JAMLICENSETRACKERRUNTIME_API);
+
+// Heap memory used by one of the plugin's data structures, split into the categories memory reviews care about
+struct JAMLICENSETRACKERRUNTIME_API FJamLicenseMemoryUsage
+{
+	// Arrays and maps from ids and names to entries
+	SIZE_T IndexTables = 0;
+
+	// Character data for URLs, object paths and license identifiers
+	SIZE_T StringPools = 0;
+
+	// License texts (default and localized)
+	SIZE_T LicenseBodies = 0;
+
+	// Anything that is derived and can be thrown away (menu summaries, sort ranks, query results)
+	SIZE_T Caches = 0;
+
+	SIZE_T GetTotal() const
+	{
+		return IndexTables + StringPools + LicenseBodies + Caches;
+	}
+
+	FJamLicenseMemoryUsage& operator+=(const FJamLicenseMemoryUsage& Other)
+	{
+		IndexTables += Other.IndexTables;
+		StringPools += Other.StringPools;
+		LicenseBodies += Other.LicenseBodies;
+		Caches += Other.Caches;
+		return *this;
+	}
+};
+
+// Per-owner memory usage of the plugin, printed by the JamLicense.MemReport console command (which memreport
+// also runs, see Config/DefaultEngine.ini)
+//
+// Anything holding license data should add itself from OnGather, in either module
+class JAMLICENSETRACKERRUNTIME_API FJamLicenseMemoryReport
+{
+public:
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnGather, FJamLicenseMemoryReport&);
+	static FOnGather& OnGather();
+
+	// Asks everything registered with OnGather for its current usage (game thread only)
+	static FJamLicenseMemoryReport Gather();
+
+	void Add(const FString& Owner, const FJamLicenseMemoryUsage& Usage);
+
+	// Writes one line per owner and a total per category
+	void Print(FOutputDevice& Ar) const;
+
+private:
+	TArray<TPair<FString, FJamLicenseMemoryUsage>> Entries;
+};
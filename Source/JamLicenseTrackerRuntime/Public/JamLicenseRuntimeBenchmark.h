@@ -0,0 +1,47 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JamLicenseBenchmark.h"
+
+// Measures what the license manifest costs a shipped game: how long it takes to load, how much memory it
+// holds, and the latency of lookups made from several threads at once
+struct JAMLICENSETRACKERRUNTIME_API FJamLicenseRuntimeBenchmark
+{
+	// Manifest to measure (defaults to the staged manifest, falling back to the harvested one)
+	FString ManifestFilename;
+
+	// Number of threads issuing queries at the same time (0 uses the number of task graph workers)
+	int32 NumThreads = 0;
+
+	// Total number of queries across all threads
+	int64 NumQueries = 4 * 1000 * 1000;
+
+	// Number of timed warm loads of the manifest (after the one cold load)
+	int32 NumLoadIterations = 10;
+
+public:
+	// Runs the benchmarks, producing ManifestLoadCold, ManifestLoadWarm, QueryByURL, QueryByPackage and
+	// EnumerateAll results. Point queries are timed in batches, so their ops/s is per thread; the combined
+	// throughput of all threads is recorded in the report context as mixedQueriesPerSecond
+	bool Run(FJamLicenseBenchmarkReport& OutReport, FString& OutError) const;
+};
@@ -0,0 +1,117 @@
+/*
+  Copyright (C) 2022 Michael Noland
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Subsystems/EngineSubsystem.h"
+#include "JamLicenseDiagnostics.h"
+#include "JamLicenseManifest.h"
+
+#include "JamLicenseTextSubsystem.generated.h"
+
+class FJamLicenseMemoryReport;
+
+// Serves license texts at runtime from the staged license manifest (see FJamLicenseManifest::GetStagedFilename)
+//
+// The manifest itself holds the default language text of every license. Localized variants live in per-culture
+// sections next to it, and only the sections for the active language (and its parent cultures) are loaded.
+// When the language changes, the new sections are read on a worker thread and swapped in once they're ready,
+// with the previous texts served until then
+UCLASS()
+class JAMLICENSETRACKERRUNTIME_API UJamLicenseTextSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Returns the license text for an asset source URL in the active language, falling back to the default text
+	UFUNCTION(BlueprintCallable, Category=License)
+	FString GetLicenseText(const FString& AssetSourceURL) const;
+
+	bool HasManifest() const
+	{
+		return bHasManifest;
+	}
+
+	const FJamLicenseManifest& GetManifest() const
+	{
+		return Manifest;
+	}
+
+	// Returns the culture whose texts are currently loaded (may lag behind the active language while a switch is streaming in)
+	const FString& GetLoadedCulture() const
+	{
+		return LoadedCulture;
+	}
+
+	const FString& GetManifestFilename() const
+	{
+		return ManifestFilename;
+	}
+
+	double GetManifestLoadSeconds() const
+	{
+		return ManifestLoadSeconds;
+	}
+
+	int32 GetNumLocalizedTexts() const
+	{
+		return LocalizedText.Num();
+	}
+
+	// Hits are GetLicenseText calls answered with a localized text, misses fell back to the default text
+	const FJamLicenseCacheCounter& GetLocalizedTextCounter() const
+	{
+		return LocalizedTextCounter;
+	}
+
+	// Reads the manifest from disk again, along with the localized texts for the active language
+	void ReloadManifest();
+
+	// Broadcast on the game thread whenever a different set of localized texts has been swapped in
+	DECLARE_MULTICAST_DELEGATE(FOnLicenseTextChanged);
+	FOnLicenseTextChanged OnLicenseTextChanged;
+
+private:
+	void OnCultureChanged();
+	void RequestCulture(const FString& CultureName);
+	void GatherMemoryUsage(FJamLicenseMemoryReport& Report) const;
+
+private:
+	FJamLicenseManifest Manifest;
+	FString ManifestFilename;
+	bool bHasManifest = false;
+	double ManifestLoadSeconds = 0.0;
+
+	// Localized texts for LoadedCulture (merged from the most specific culture section down to its parents)
+	TMap<FString, FString> LocalizedText;
+	FString LoadedCulture;
+
+	// Incremented for every culture request, so a slow load that has been superseded is dropped
+	uint32 LoadSerial = 0;
+
+	FDelegateHandle MemoryReportHandle;
+
+	mutable FJamLicenseCacheCounter LocalizedTextCounter;
+};